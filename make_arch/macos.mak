@@ -9,5 +9,7 @@ CXX = ${HOME}/dbs_lib/lib_MPICH-4.1-OFI-1.16.1/bin/mpicxx
 
 CXXFLAGS = -fopenmp -O3 -fsanitize=address -Wno-deprecated-declarations -Wno-format-security
 LDFLAGS = -fopenmp -fsanitize=address 
+# the symbols of the plugins are resolved when loaded by benchme
+PLUGIN_FLAGS = -shared -undefined dynamic_lookup
 
 #-------------------------------------------------------------------------------
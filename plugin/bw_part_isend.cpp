@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "part_registry.hpp"
+#include "test_part_bw.hpp"
+
+/* Example of a strategy loaded as a plugin: one non-persistent MPI_Isend/MPI_Irecv per partition
+ *
+ * build: make plugin
+ * run:   mpiexec -n 2 ./benchme -plugin plugin/bw_part_isend.so -strategy isend
+ */
+class BwPartIsend : public TestPartBw {
+    MPI_Comm     comm_;
+    MPI_Request* rqst_;
+    double*      buf_;
+    int          count_;
+    int          buddy_;
+
+   public:
+    BwPartIsend() = delete;
+    explicit BwPartIsend(part_arg_t arg) : TestPartBw(arg) {
+        std::tuple<> v;
+        m_info(v);
+    };
+
+   protected:
+    void FileName(const int len, char* filename) override {
+        char subname[512];
+        TestPartBw::FileName(512, subname);
+        snprintf(filename, len, "bw_isend_%s", subname);
+    }
+
+    void RequestInit(TestPartInfo* info) override {
+        int rank, comm_size;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
+
+        buddy_ = get_friend(rank, comm_size);
+        buf_   = info->buf;
+        count_ = info->size.per_part;
+        rqst_  = (MPI_Request*)malloc(n_part * sizeof(MPI_Request));
+        MPI_Comm_dup(MPI_COMM_WORLD, &comm_);
+    }
+    void Send_StartPreCompute() override {
+#pragma omp barrier
+    }
+    void Send_Pready(const int i_part) override {
+        MPI_Isend(buf_ + i_part * count_, count_, MPI_DOUBLE, buddy_, i_part, comm_, rqst_ + i_part);
+    }
+    void Send_StartPostCompute() override {
+#pragma omp for schedule(static) nowait
+        for (int ip = 0; ip < n_part; ++ip) {
+            MPI_Wait(rqst_ + ip, MPI_STATUS_IGNORE);
+        }
+#pragma omp barrier
+    }
+    void Recv_StartPreCompute() override {
+#pragma omp barrier
+#pragma omp for schedule(static) nowait
+        for (int ip = 0; ip < n_part; ++ip) {
+            MPI_Irecv(buf_ + ip * count_, count_, MPI_DOUBLE, buddy_, ip, comm_, rqst_ + ip);
+        }
+    }
+    void Recv_Pready(const int i_part) override {
+        MPI_Wait(rqst_ + i_part, MPI_STATUS_IGNORE);
+    }
+    void Recv_StartPostCompute() override {
+#pragma omp barrier
+    }
+    void RequestCleanup(TestPartInfo* info) override {
+        MPI_Comm_free(&comm_);
+        free(rqst_);
+    }
+};
+
+m_plugin_register() {
+    PartRegistry::Register("isend", part_new<BwPartIsend>);
+}
@@ -0,0 +1,145 @@
+"""Reader of the raw samples written by benchme with `-raw 1`.
+
+The files results/raw_r<rank>.idx and results/raw_r<rank>.bin are mapped in memory, nothing is parsed.
+Used as a script, recompute the reported numbers of every test and size (see TestPartBw::run):
+
+    python raw.py [folder] [test] [stat]
+
+prints `size, t_send, t_recv, t_cmpt, time, ci_send, ci_recv, ci_cmpt, ci_time, t_consume, ci_consume`, the row of the
+results file: the time is the one of the receiver minus the kernel of the sender and the consumer of the receiver
+(stored as the t_cmpt of the receiver), their standard deviations are combined in the CI.
+It is followed by `mean, median, p90, p99, p999, trim` as in the file prefixed by `stats_`.
+The ranks are the n_ranks ones of the run recorded in the index, the files of another run are ignored.
+stat is the `stat` key of the run (mean by default). Except for the mean, the CI of the time is a bootstrap one,
+statistically equivalent to the one of benchme but drawn from other resamples.
+"""
+import os
+import sys
+
+import numpy as np
+
+# see part_raw_entry_t in src/raw.hpp
+ENTRY = np.dtype([('test', 'S512'), ('size', '<i8'), ('offset', '<i8'), ('n_iter', '<i4'), ('i_first', '<i4'),
+                  ('n_threads', '<i4'), ('rank', '<i4'), ('n_ranks', '<i4'), ('sender', '<i4'), ('pingpong', '<i4'),
+                  ('reserved', '<i4')])
+
+# the t_nu of the 90% CI, see t_nu_interp() in src/test_part_bw.cpp
+T_NU = {0: 0.0, 1: 6.314, 2: 2.920, 3: 2.353, 4: 2.132, 5: 2.015, 7: 1.895, 10: 1.812, 15: 1.753, 20: 1.725,
+        30: 1.697, 50: 1.676, 100: 1.660, 1000: 1.645}
+STAT_TRIM = 0.1
+STAT_BOOT = 1000
+STATS = ['mean', 'median', 'p90', 'p99', 'p999', 'trim']
+
+
+def t_nu(nu):
+    keys = sorted(T_NU)
+    if nu >= keys[-1]:
+        return T_NU[keys[-1]]
+    return float(np.interp(nu, keys, [T_NU[k] for k in keys]))
+
+
+def diff_ci(s_ref, s_cmpt, n):
+    s_p = np.sqrt(0.5 * (s_ref ** 2 + s_cmpt ** 2))
+    return t_nu(2 * n - 2) * s_p * np.sqrt(2.0 / n)
+
+
+class RawRank:
+    """the samples of one rank: `index` is a structured array of part_raw_entry_t, `block(i)` the columns of entry i"""
+
+    def __init__(self, folder, rank):
+        self.index = np.memmap(os.path.join(folder, f"raw_r{rank}.idx"), dtype=ENTRY, mode='r')
+        self.data = np.memmap(os.path.join(folder, f"raw_r{rank}.bin"), dtype='<f8', mode='r')
+
+    def block(self, i):
+        e = self.index[i]
+        n, nt, off = int(e['n_iter']), int(e['n_threads']), int(e['offset'])
+        col = lambda k: self.data[off + k * n:off + (k + 1) * n]
+        return {'t_iter': col(0), 't_cmpt': col(1),
+                't_thread': self.data[off + 2 * n:off + (2 + nt) * n].reshape(nt, n),
+                'c_thread': self.data[off + (2 + nt) * n:off + (2 + 2 * nt) * n].reshape(nt, n)}
+
+
+def load(folder="."):
+    """the ranks of the run which wrote raw_r0, every one of them must have its files"""
+    first = RawRank(folder, 0)
+    if len(first.index) == 0:
+        raise ValueError(f"{folder}: raw_r0.idx has no entry")
+    n_ranks = int(first.index[0]['n_ranks'])
+    missing = [r for r in range(1, n_ranks) for ext in ("idx", "bin")
+               if not os.path.isfile(os.path.join(folder, f"raw_r{r}.{ext}"))]
+    if missing:
+        raise FileNotFoundError(f"{folder}: the run has {n_ranks} ranks, "
+                                f"the files of ranks {sorted(set(missing))} are missing")
+    ranks = [first] + [RawRank(folder, r) for r in range(1, n_ranks)]
+    for r, raw in enumerate(ranks):
+        same_run = np.all(raw.index['n_ranks'] == n_ranks) and np.all(raw.index['rank'] == r)
+        if len(raw.index) != len(first.index) or not same_run:
+            raise ValueError(f"{folder}: raw_r{r}.idx does not belong to the run of raw_r0.idx")
+    return ranks
+
+
+def stat_all(sample):
+    s = np.sort(sample)
+    n = len(s)
+    n_trim = min(int(STAT_TRIM * n), (n - 1) // 2)
+    return [s.mean(), np.quantile(s, 0.5), np.quantile(s, 0.9), np.quantile(s, 0.99), np.quantile(s, 0.999),
+            s[n_trim:n - n_trim].mean()]
+
+
+def boot_ci(sample, stat):
+    """the half-width of the 90% percentile-bootstrap CI of the statistic, see stat_boot_ci() in src/stats.cpp"""
+    rng = np.random.default_rng(2023)
+    boot = [stat_all(rng.choice(sample, len(sample)))[STATS.index(stat)] for _ in range(STAT_BOOT)]
+    return 0.5 * (np.quantile(boot, 0.95) - np.quantile(boot, 0.05))
+
+
+def report(ranks, test=None, stat='mean'):
+    """recompute the reported numbers, returns {test: [(size, [results row], [stats row]), ...]}"""
+    out = {}
+    n_ranks = int(ranks[0].index[0]['n_ranks'])
+    n_pair = n_ranks // 2
+    # the blocks are appended in the same order on every rank
+    for i, e in enumerate(ranks[0].index):
+        name = e['test'].decode()
+        if test is not None and name != test:
+            continue
+        pingpong = bool(e['pingpong'])
+        factor = 0.5 if pingpong else 1.0
+        avg = np.zeros(8)
+        stats = np.zeros(6)
+        ci_stat = 0.0
+        for ip in range(n_pair):
+            send = ranks[ip].block(i)
+            recv = ranks[ip + n_pair].block(i)
+            i0 = int(ranks[ip].index[i]['i_first'])
+            t_send, t_cmpt = send['t_iter'][i0:], send['t_cmpt'][i0:]
+            # the receiver stores the time in the consumer as its t_cmpt
+            t_recv, t_cons = recv['t_iter'][i0:], recv['t_cmpt'][i0:]
+            avg += np.array([t_send.mean(), t_send.std(ddof=1), t_cmpt.mean(), t_cmpt.std(ddof=1), t_recv.mean(),
+                             t_recv.std(ddof=1), t_cons.mean(), t_cons.std(ddof=1)]) / n_pair
+            t_ref = t_send if pingpong else t_recv
+            sample = factor * (t_ref - t_cmpt - t_cons)
+            stats += np.array(stat_all(sample)) / n_pair
+            if stat != 'mean':
+                ci_stat += boot_ci(sample, stat) / n_pair
+        n = int(e['n_iter'] - e['i_first'])
+        t_zero, s_zero, t_cmpt, s_cmpt, t_recv, s_recv, t_cons, s_cons = avg
+        t_ref, s_ref = (t_zero, s_zero) if pingpong else (t_recv, s_recv)
+        ci = t_nu(n) * np.sqrt(1.0 / n)
+        row = [t_zero, t_recv, t_cmpt, factor * (t_ref - t_cmpt - t_cons), s_zero * ci, s_recv * ci, s_cmpt * ci,
+               factor * diff_ci(s_ref, np.sqrt(s_cmpt ** 2 + s_cons ** 2), n), t_cons, s_cons * ci]
+        if stat != 'mean':
+            row[3] = stats[STATS.index(stat)]
+            row[7] = ci_stat
+        out.setdefault(name, []).append((int(e['size']), row, list(stats)))
+    return out
+
+
+if __name__ == "__main__":
+    folder = sys.argv[1] if len(sys.argv) > 1 else "."
+    test = sys.argv[2] if len(sys.argv) > 2 else None
+    stat = sys.argv[3] if len(sys.argv) > 3 else 'mean'
+    for name, rows in report(load(folder), test, stat).items():
+        print(f"# {name}")
+        for size, row, stats in rows:
+            print(",".join([str(size)] + [f"{v:e}" for v in row]) + " | " + ",".join(f"{v:e}" for v in stats))
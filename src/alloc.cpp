@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "alloc.hpp"
+
+#include <sys/mman.h>
+
+#include <cstdlib>
+#include <map>
+
+#include "tools.hpp"
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+// the size and the mapping of the blocks obtained with mmap, the other ones come from posix_memalign
+typedef struct {
+    void*  base;
+    size_t size;
+} part_map_t;
+static std::map<void*, part_map_t> part_map;
+
+static constexpr size_t part_2m = (size_t)1 << 21;
+static constexpr size_t part_1g = (size_t)1 << 30;
+
+void* part_malloc(const size_t size, const int page, const size_t align) {
+    m_assert(align > 0 && (align & (align - 1)) == 0, "the alignment %zu must be a power of 2", align);
+    switch (page) {
+        case (part_page_default):
+        case (part_page_thp): {
+            // the huge pages are only used if the block is aligned on them
+            const size_t alignment = (page == part_page_thp) ? m_max(align, part_2m) : m_max(align, sizeof(void*));
+            void*        ptr       = nullptr;
+            const int    err       = posix_memalign(&ptr, alignment, m_max(size, (size_t)1));
+            m_assert(err == 0, "unable to allocate %zu bytes aligned on %zu", size, alignment);
+            if (page == part_page_thp) {
+#ifdef MADV_HUGEPAGE
+                madvise(ptr, size, MADV_HUGEPAGE);
+#else
+                m_assert(false, "the transparent huge pages are not supported on this system");
+#endif
+            }
+            return ptr;
+        }
+        case (part_page_2m):
+        case (part_page_1g): {
+#ifdef MAP_HUGETLB
+            const size_t page_size = (page == part_page_2m) ? part_2m : part_1g;
+            const int    page_log  = (page == part_page_2m) ? 21 : 30;
+            // the pages are aligned on their size, a larger alignment is obtained with a larger mapping
+            const size_t extra = (align > page_size) ? align : 0;
+            const size_t len   = ((size + extra + page_size - 1) / page_size) * page_size;
+            void*        base  = mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (page_log << MAP_HUGE_SHIFT), -1, 0);
+            m_assert(base != MAP_FAILED, "unable to map %zu bytes of %zu B huge pages, are they reserved?", len, page_size);
+            void* ptr = (void*)((((size_t)base) + align - 1) & ~(align - 1));
+            part_map[ptr] = {base, len};
+            return ptr;
+#else
+            m_assert(false, "the hugetlbfs pages are not supported on this system");
+            return nullptr;
+#endif
+        }
+        default:
+            m_assert(false, "unknown page type %d", page);
+            return nullptr;
+    }
+}
+
+void part_free(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    const auto it = part_map.find(ptr);
+    if (it == part_map.end()) {
+        free(ptr);
+    } else {
+        munmap(it->second.base, it->second.size);
+        part_map.erase(it);
+    }
+}
+
+void part_first_touch(double* buf, const size_t per_part, const int n_part, const double value) {
+#pragma omp parallel for schedule(static)
+    for (int ip = 0; ip < n_part; ++ip) {
+        for (size_t i = ip * per_part; i < (ip + 1) * per_part; ++i) {
+            buf[i] = value;
+        }
+    }
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef ALLOC_HPP_
+#define ALLOC_HPP_
+
+#include <cstddef>
+
+// the pages backing the buffers
+enum part_page_t {
+    part_page_default = 0,  // the pages given by malloc
+    part_page_thp     = 1,  // transparent huge pages, requested with madvise
+    part_page_2m      = 2,  // 2 MB huge pages from hugetlbfs, they must be reserved
+    part_page_1g      = 3,  // 1 GB huge pages from hugetlbfs, they must be reserved
+};
+
+/* Allocate size bytes backed by the given pages and aligned on align bytes (a power of 2)
+ *
+ * The memory is not touched: the pages are placed on the NUMA domain of the thread writing them first,
+ * see part_first_touch(). The memory must be freed with part_free().
+ */
+void* part_malloc(const size_t size, const int page, const size_t align);
+void  part_free(void* ptr);
+
+/* Write value in every partition of buf from the thread owning it
+ *
+ * The partitions are distributed with schedule(static) over the n_part partitions, i.e. the same mapping as the
+ * loops of the test, so that each partition lives on the NUMA domain of the thread which produces or consumes it.
+ */
+void part_first_touch(double* buf, const size_t per_part, const int n_part, const double value);
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "arena.hpp"
+
+#include <mpi.h>
+
+#include <cstdint>
+
+#include "alloc.hpp"
+#include "tools.hpp"
+#include "win_cache.hpp"
+
+PartArena::slot_t PartArena::slot_[part_slot_n];
+
+void* PartArena::Get(const int arena, const int slot, const size_t size, const size_t max_size, const int page,
+                     const size_t align) {
+    if (arena == part_arena_none) {
+        return part_malloc(size, page, align);
+    }
+    m_assert(0 <= slot && slot < part_slot_n, "unknown arena slot %d", slot);
+    m_assert(size <= max_size, "the size %zu is above the maximum size %zu", size, max_size);
+    slot_t* curr = slot_ + slot;
+    // reuse the buffer if it is large enough and allocated with the same options
+    if (curr->ptr != nullptr && curr->arena == arena && curr->size >= max_size && curr->page == page &&
+        curr->align == align) {
+        return curr->ptr;
+    }
+    Free_(curr);
+    if (arena == part_arena_malloc) {
+        curr->ptr = part_malloc(max_size, page, align);
+        m_assert(((uintptr_t)curr->ptr % align) == 0, "the arena buffer %p is not aligned on %zu bytes", curr->ptr,
+                 align);
+    } else {
+        m_assert(arena == part_arena_mpi, "unknown arena %d", arena);
+        MPI_Alloc_mem(max_size, MPI_INFO_NULL, &curr->ptr);
+    }
+    curr->size  = max_size;
+    curr->arena = arena;
+    curr->page  = page;
+    curr->align = align;
+    return curr->ptr;
+}
+
+void PartArena::Release(const int arena, void* ptr) {
+    // the arena keeps its buffers
+    if (arena == part_arena_none) {
+        part_free(ptr);
+    }
+}
+
+void PartArena::Free_(slot_t* slot) {
+    if (slot->ptr == nullptr) {
+        return;
+    }
+    // the cached windows cannot outlive the memory they expose
+    PartWinCache::Release(slot->ptr, slot->size);
+    if (slot->arena == part_arena_mpi) {
+        MPI_Free_mem(slot->ptr);
+    } else {
+        part_free(slot->ptr);
+    }
+    slot->ptr  = nullptr;
+    slot->size = 0;
+}
+
+void PartArena::Free() {
+    for (int is = 0; is < part_slot_n; ++is) {
+        Free_(slot_ + is);
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef ARENA_HPP_
+#define ARENA_HPP_
+
+#include <cstddef>
+
+// the origin of the buffers
+enum part_arena_t {
+    part_arena_none   = 0,  // a new buffer for every size of every test
+    part_arena_malloc = 1,  // one buffer per slot for the whole benchmark, see part_malloc()
+    part_arena_mpi    = 2,  // one buffer per slot for the whole benchmark, from MPI_Alloc_mem
+};
+
+// the buffers used by a test
+enum part_slot_t {
+    part_slot_buf  = 0,  // the send and receive buffer
+    part_slot_aux0 = 1,  // the first input of the compute kernels
+    part_slot_aux1 = 2,  // the second input of the compute kernels
+    part_slot_out  = 3,  // the output of the consume kernels
+    part_slot_n    = 4,
+};
+
+/* Buffers shared by all the tests and all the sizes
+ *
+ * Without arena, Get() allocates size bytes and Release() frees them.
+ * With an arena, the buffer of a slot is allocated once with max_size bytes and every test and size uses its beginning.
+ * The memory being registered only once by the network, the registration cost leaves the measurement.
+ * The pages of the arena stay where they have been first touched, i.e. by the partitions of the first size.
+ * The buffer of a slot is reallocated if the arena, the pages or the alignment change.
+ */
+class PartArena {
+   public:
+    static void* Get(const int arena, const int slot, const size_t size, const size_t max_size, const int page,
+                     const size_t align);
+    static void  Release(const int arena, void* ptr);
+    // free the arena, must be called before MPI_Finalize
+    static void Free();
+
+   private:
+    typedef struct {
+        void*  ptr   = nullptr;
+        size_t size  = 0;
+        int    arena = part_arena_none;
+        int    page  = 0;  // the pages and the alignment asked for the buffer, a change reallocates it
+        size_t align = 0;
+    } slot_t;
+    static slot_t slot_[part_slot_n];
+
+    static void Free_(slot_t* slot);
+};
+
+#endif
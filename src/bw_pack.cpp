@@ -3,7 +3,6 @@
  *	See COPYRIGHT in top-level directory
  */
 #include "bw_pack.hpp"
-#include <cstring>
 
 // we send bcount * bsize doubles continuous in memory
 void BwPack::SetupComm(const int n_msg, const int max_count, BwDtypeInfo* info) {
@@ -24,23 +23,28 @@ void BwPack::UpsetComm(const int max_count, const int n_info, BwDtypeInfo* info)
     free(usr_buf);
 }
 
+// the count * bcount blocks of message i_msg, they follow the ones of the previous messages
+static pack_layout_t pack_layout(const int count, const int bcount, const int bsize, const int bstride) {
+    pack_layout_t layout;
+    layout.len       = bsize;
+    layout.n[0]      = (size_t)count * bcount;
+    layout.n[1]      = 1;
+    layout.n[2]      = 1;
+    layout.stride[0] = bstride;
+    layout.stride[1] = 0;
+    layout.stride[2] = 0;
+    return layout;
+}
+
 // do the packing from the usr buffer to buff
 void BwPack::PreSend(const int i_msg, const int count, char* buf) {
-    const size_t usr_shift = i_msg * count * bstride;
-    for (int i = 0; i < (count * bcount); ++i) {
-        // comm buff increments by bsize, user_buf increment by bstride
-        double* l_buf     = ((double*)buf) + i * bsize;
-        double* l_usr_buf = ((double*)usr_buf) + usr_shift + i * bstride;
-        std::memcpy(l_usr_buf, l_buf, bsize);
-    }
+    const size_t        usr_shift = (size_t)i_msg * count * bcount * bstride;
+    const pack_layout_t layout    = pack_layout(count, bcount, bsize, bstride);
+    pack_kernel(kernel, &layout, ((double*)usr_buf) + usr_shift, (double*)buf);
 }
 // do the unpacking from buf to the usr buffer
 void BwPack::PostRecv(const int i_msg, const int count, char* buf) {
-    const size_t usr_shift = i_msg * count * bstride;
-    for (int i = 0; i < (count * bcount); ++i) {
-        // comm buff increments by bsize, user_buf increment by bstride
-        double* l_buf     = ((double*)buf) + i * bsize;
-        double* l_usr_buf = ((double*)usr_buf) + usr_shift + i * bstride;
-        std::memcpy(l_buf, l_usr_buf, bsize);
-    }
+    const size_t        usr_shift = (size_t)i_msg * count * bcount * bstride;
+    const pack_layout_t layout    = pack_layout(count, bcount, bsize, bstride);
+    unpack_kernel(kernel, &layout, (double*)buf, ((double*)usr_buf) + usr_shift);
 }
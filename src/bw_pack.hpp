@@ -5,17 +5,20 @@
 #ifndef BW_PACK_HPP_
 #define BW_PACK_HPP_
 
+#include "pack.hpp"
 #include "tools.hpp"
 #include "test_pt2pt_bw.hpp"
 
+// bw_arg_t + the block count, size and stride + the pack kernel (see part_pack_t)
 using bw_pack_arg_t = test::merge<bw_arg_t,
-                                   std::tuple<int, int, int> >::type;
+                                   std::tuple<int, int, int, int> >::type;
 
 class BwPack: public TestPt2PtBw{
    private:
     const int bcount;   // the number of blocks within a data-type
     const int bsize;    // the size of a block
     const int bstride;  // the stride of a block
+    const int kernel;   // the pack kernel, see part_pack_t
 
     char* usr_buf;
 
@@ -23,13 +26,14 @@ class BwPack: public TestPt2PtBw{
     BwPack(bw_pack_arg_t arg) : TestPt2PtBw(m_head(bw_arg_s, arg)),
                                 bcount{std::get<bw_arg_s + 0>(arg)},
                                 bsize{std::get<bw_arg_s + 1>(arg)},
-                                bstride{std::get<bw_arg_s + 2>(arg)} {
+                                bstride{std::get<bw_arg_s + 2>(arg)},
+                                kernel{std::get<bw_arg_s + 3>(arg)} {
         m_info(arg);
         m_assert(bstride >= bsize, "you cannot have a strice = %d < size = %d", bstride, bsize);
     };
 
     virtual void Filename(const int len, char* name) override {
-        snprintf(name, len, "bw_pack_bcount%d_bsize%d_bstride%d.txt", bcount, bsize, bstride);
+        snprintf(name, len, "bw_pack_%s_bcount%d_bsize%d_bstride%d.txt", pack_name(kernel), bcount, bsize, bstride);
     }
 
     virtual void SetupComm(const int max_count, const int n_info, BwDtypeInfo* info) override;
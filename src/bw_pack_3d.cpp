@@ -3,7 +3,6 @@
  *	See COPYRIGHT in top-level directory
  */
 #include "bw_pack_3d.hpp"
-#include <cstring>
 
 // we send bcount * bsize doubles continuous in memory
 void BwPack3D::SetupComm(const int n_msg, const int max_count, BwDtypeInfo* info) {
@@ -24,38 +23,28 @@ void BwPack3D::UpsetComm(const int max_count, const int n_info, BwDtypeInfo* inf
     free(usr_buf);
 }
 
+// the bn[0] x bn[1] x bn[2] corner of count blocks of n[0] x n[1] x n[2]
+static pack_layout_t pack_layout(const int count, const int bn[3], const int n[3]) {
+    pack_layout_t layout;
+    layout.len       = bn[0];
+    layout.n[0]      = bn[1];
+    layout.n[1]      = bn[2];
+    layout.n[2]      = count;
+    layout.stride[0] = n[0];
+    layout.stride[1] = (size_t)n[0] * n[1];
+    layout.stride[2] = (size_t)n[0] * n[1] * n[2];
+    return layout;
+}
+
 // do the packing from the usr buffer to buff
 void BwPack3D::PreSend(const int i_msg, const int count, char* buf) {
-    const size_t  usr_shift = i_msg * count * n[0] * n[1] * n[2];
-    const double* ubuf      = ((double*)(usr_buf)) + usr_shift;
-    double*       cbuf      = ((double*)(buf));
-
-    for (int ic = 0; ic < count; ++ic) {
-        for (int i2 = 0; i2 < bn[2]; ++i2) {
-            for (int i1 = 0; i1 < bn[1]; ++i1) {
-                // we use memcopy for the bn[0] continuous elements
-                const int uidx = n[0] * (i1 + n[1] * (i2 + n[2] * ic));
-                const int cidx = bn[0] * (i1 + bn[1] * (i2 + bn[2] * ic));
-                std::memcpy(cbuf + cidx, ubuf + uidx, bn[0] * sizeof(double));
-            }
-        }
-    }
+    const size_t        usr_shift = (size_t)i_msg * count * n[0] * n[1] * n[2];
+    const pack_layout_t layout    = pack_layout(count, bn, n);
+    pack_kernel(kernel, &layout, ((double*)usr_buf) + usr_shift, (double*)buf);
 }
 // do the unpacking from buf to the usr buffer
 void BwPack3D::PostRecv(const int i_msg, const int count, char* buf) {
-    const size_t  usr_shift = i_msg * count * n[0] * n[1] * n[2];
-    double*       ubuf      = ((double*)(usr_buf)) + usr_shift;
-    const double* cbuf      = ((double*)(buf));
-
-    for (int ic = 0; ic < count; ++ic) {
-        for (int i2 = 0; i2 < bn[2]; ++i2) {
-            for (int i1 = 0; i1 < bn[1]; ++i1) {
-                // we use memcopy for the bn[0] continuous elements
-                const int uidx = n[0] * (i1 + n[1] * (i2 + n[2] * ic));
-                const int cidx = bn[0] * (i1 + bn[1] * (i2 + bn[2] * ic));
-                std::memcpy(ubuf + uidx, cbuf + cidx, bn[0] * sizeof(double));
-            }
-        }
-    }
+    const size_t        usr_shift = (size_t)i_msg * count * n[0] * n[1] * n[2];
+    const pack_layout_t layout    = pack_layout(count, bn, n);
+    unpack_kernel(kernel, &layout, (double*)buf, ((double*)usr_buf) + usr_shift);
 }
-
@@ -15,7 +15,7 @@ void BwPart::RequestInit(TestPartInfo* info) {
 
     n_rqst_ = 1;
     //rqst_   = (MPI_Request*)malloc(sizeof(MPI_Request));
-    if (is_sender(rank, comm_size)) {
+    if (IsSender()) {
         MPI_Psend_init(info->buf, n_part, info->size.per_part, MPI_DOUBLE, buddy, tag, MPI_COMM_WORLD, MPI_INFO_NULL, &rqst_);
     } else {
         MPI_Precv_init(info->buf, n_part, info->size.per_part, MPI_DOUBLE, buddy, tag, MPI_COMM_WORLD, MPI_INFO_NULL, &rqst_);
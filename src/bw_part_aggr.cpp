@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "bw_part_aggr.hpp"
+#include "mpi.h"
+
+void BwPartAggr::RequestInit(TestPartInfo* info) {
+    int rank, comm_size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
+
+    // tag 0 is already used!
+    const int tag   = 1;
+    const int buddy = get_friend(rank, comm_size);
+
+    n_group_ = (n_part + aggr_ - 1) / aggr_;
+    rqst_    = (MPI_Request*)malloc(n_group_ * sizeof(MPI_Request));
+    count_   = std::vector<std::atomic<int>>(n_group_);
+
+    for (int ig = 0; ig < n_group_; ++ig) {
+        // the last group might be smaller
+        const int n_in  = m_min(aggr_, n_part - ig * aggr_);
+        const int count = n_in * info->size.per_part;
+        double*   buf   = info->buf + ig * aggr_ * info->size.per_part;
+        count_[ig].store(0, std::memory_order_relaxed);
+
+        MPI_Comm part_comm;
+        MPI_Comm_dup(MPI_COMM_WORLD, &part_comm);
+        if (IsSender()) {
+            MPI_Send_init(buf, count, MPI_DOUBLE, buddy, tag + ig, part_comm, rqst_ + ig);
+        } else {
+            MPI_Recv_init(buf, count, MPI_DOUBLE, buddy, tag + ig, part_comm, rqst_ + ig);
+        }
+        MPI_Comm_free(&part_comm);
+    }
+}
+
+void BwPartAggr::Send_StartPreCompute() {
+#pragma omp barrier
+}
+void BwPartAggr::Send_Pready(const int i_part) {
+    const int ig   = i_part / aggr_;
+    const int n_in = m_min(aggr_, n_part - ig * aggr_);
+    // the last ready partition of the group sends it, the counter is reset for the next iteration
+    if (count_[ig].fetch_add(1, std::memory_order_acq_rel) == (n_in - 1)) {
+        count_[ig].store(0, std::memory_order_relaxed);
+        MPI_Start(rqst_ + ig);
+    }
+}
+void BwPartAggr::Send_StartPostCompute() {
+    // a group might be started by another thread than the one waiting for it
+#pragma omp barrier
+#pragma omp for schedule(static) nowait
+    for (int ig = 0; ig < n_group_; ++ig) {
+        MPI_Wait(rqst_ + ig, MPI_STATUS_IGNORE);
+    }
+#pragma omp barrier
+}
+
+void BwPartAggr::Recv_StartPreCompute() {
+#pragma omp barrier
+    // the implicit barrier makes the reset visible before any Recv_Pready
+#pragma omp for schedule(static)
+    for (int ig = 0; ig < n_group_; ++ig) {
+        count_[ig].store(0, std::memory_order_relaxed);
+        MPI_Start(rqst_ + ig);
+    }
+}
+void BwPartAggr::Recv_Pready(const int i_part) {
+    const int ig = i_part / aggr_;
+    // the thread owning the first partition waits for the group, the other ones wait for that thread.
+    // the first partition is owned by the same or by a previous thread, which cannot wait on us
+    if (i_part == ig * aggr_) {
+        MPI_Wait(rqst_ + ig, MPI_STATUS_IGNORE);
+        count_[ig].store(1, std::memory_order_release);
+    } else {
+        while (count_[ig].load(std::memory_order_acquire) == 0) {
+        }
+    }
+}
+void BwPartAggr::Recv_StartPostCompute() {
+#pragma omp barrier
+}
+
+void BwPartAggr::RequestCleanup(TestPartInfo* info) {
+    for (int ig = 0; ig < n_group_; ++ig) {
+        MPI_Request_free(rqst_ + ig);
+    }
+    free(rqst_);
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef BW_PART_AGGR_HPP_
+#define BW_PART_AGGR_HPP_
+#include <atomic>
+#include <vector>
+
+#include "test_part_bw.hpp"
+
+// part_arg_t + the number of partitions aggregated in one message
+using part_aggr_arg_t = test::merge<part_arg_t, std::tuple<int>>::type;
+
+/* user-level aggregation of the partitions: a group of aggr contiguous partitions is sent as one message
+ * by the last thread marking one of them as ready (the equivalent of MPIR_CVAR_PART_AGGR_SIZE).
+ * On the receiver, the thread owning the first partition of a group waits for the message.
+ */
+class BwPartAggr : public TestPartBw {
+    const int aggr_;  // the number of partitions in a group
+
+    int                           n_group_;
+    MPI_Request*                  rqst_;
+    std::vector<std::atomic<int>> count_;  // the number of ready (sender) or arrived (receiver) partitions of a group
+
+   public:
+    BwPartAggr() = delete;
+    explicit BwPartAggr(part_aggr_arg_t arg) : TestPartBw(m_head(part_arg_s, arg)),
+                                               aggr_{std::get<part_arg_s + 0>(arg)} {
+        m_info(arg);
+        m_assert(aggr_ > 0, "the aggregation = %d must be positive", aggr_);
+    };
+
+   protected:
+    void FileName(const int len, char* filename) override {
+        char subname[512];
+        TestPartBw::FileName(512, subname);
+        snprintf(filename, len, "bw_aggr%d_%s", aggr_, subname);
+    }
+
+    void RequestInit(TestPartInfo* info) override;
+    void Send_StartPreCompute() override;
+    void Send_StartPostCompute() override;
+    void Send_Pready(const int i_part) override;
+    void Recv_StartPreCompute() override;
+    void Recv_StartPostCompute() override;
+    void Recv_Pready(const int i_part) override;
+    void RequestCleanup(TestPartInfo* info) override;
+};
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "bw_part_dtype.hpp"
+
+#include <omp.h>
+
+#include <cstring>
+#include <numeric>
+
+#include "alloc.hpp"
+
+BwPartDtype::BwPartDtype(part_dtype_arg_t arg, const int method) : TestPartBw(m_head(part_arg_s, arg)),
+                                                                   method_{method},
+                                                                   block_{std::get<part_arg_s + 0>(arg)},
+                                                                   stride_{std::get<part_arg_s + 1>(arg)} {
+    m_info(arg);
+    m_assert(block_ > 0, "the block = %d must be positive", block_);
+    m_assert(stride_ >= 1, "the stride = %d must be at least 1 run", stride_);
+
+    // a slab of the largest size spans per_part * stride doubles
+    const size_t slab = (size_t)(max_count / n_part) * stride_;
+    usr_ = (double*)part_malloc(n_part * slab * sizeof(double), opt_.page, opt_.align);
+    // main() resets the number of threads between the tests, the slabs are touched by the threads of this one as in
+    // run(). RequestInit() is timed as the setup, the touch is not done there
+    omp_set_num_threads(n_threads);
+    part_first_touch(usr_, slab, n_part, 1.0);
+}
+
+BwPartDtype::~BwPartDtype() {
+    part_free(usr_);
+}
+
+void BwPartDtype::RequestInit(TestPartInfo* info) {
+    int rank, comm_size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
+
+    // tag = 0 is already used
+    const int tag   = 1;
+    const int buddy = get_friend(rank, comm_size);
+
+    per_part_ = info->size.per_part;
+    blen_     = std::gcd(per_part_, (size_t)block_);
+    n_run_    = per_part_ / blen_;
+    buf_      = info->buf;
+
+    if (method_ == part_strided_dtype) {
+        // n_run runs of blen doubles, the extent is the one of a slab so that the partitions follow each other
+        MPI_Datatype run_dtype;
+        MPI_Type_vector(n_run_, blen_, stride_ * blen_, MPI_DOUBLE, &run_dtype);
+        MPI_Type_create_resized(run_dtype, 0, n_run_ * stride_ * blen_ * sizeof(double), &dtype_);
+        MPI_Type_commit(&dtype_);
+        MPI_Type_free(&run_dtype);
+        if (IsSender()) {
+            MPI_Psend_init(usr_, n_part, 1, dtype_, buddy, tag, MPI_COMM_WORLD, MPI_INFO_NULL, &rqst_);
+        } else {
+            MPI_Precv_init(usr_, n_part, 1, dtype_, buddy, tag, MPI_COMM_WORLD, MPI_INFO_NULL, &rqst_);
+        }
+    } else {
+        if (IsSender()) {
+            MPI_Psend_init(buf_, n_part, per_part_, MPI_DOUBLE, buddy, tag, MPI_COMM_WORLD, MPI_INFO_NULL, &rqst_);
+        } else {
+            MPI_Precv_init(buf_, n_part, per_part_, MPI_DOUBLE, buddy, tag, MPI_COMM_WORLD, MPI_INFO_NULL, &rqst_);
+        }
+    }
+}
+
+void BwPartDtype::Send_StartPreCompute() {
+#pragma omp master
+    {
+        MPI_Start(&rqst_);
+    }
+#pragma omp barrier
+}
+void BwPartDtype::Send_Pready(const int i_part) {
+    if (method_ == part_strided_pack) {
+        const double* slab = Slab_(i_part);
+        double*       buf  = buf_ + i_part * per_part_;
+        for (size_t ir = 0; ir < n_run_; ++ir) {
+            std::memcpy(buf + ir * blen_, slab + ir * stride_ * blen_, blen_ * sizeof(double));
+        }
+    }
+    MPI_Pready(i_part, rqst_);
+}
+void BwPartDtype::Send_StartPostCompute() {
+#pragma omp barrier
+#pragma omp master
+    {
+        MPI_Wait(&rqst_, MPI_STATUS_IGNORE);
+    }
+}
+
+void BwPartDtype::Recv_StartPreCompute() {
+#pragma omp master
+    {
+        MPI_Start(&rqst_);
+    }
+#pragma omp barrier
+}
+void BwPartDtype::Recv_Pready(const int i_part) {
+    int flag;
+    do {
+        MPI_Parrived(rqst_, i_part, &flag);
+    } while (!flag);
+    if (method_ == part_strided_pack) {
+        double*       slab = Slab_(i_part);
+        const double* buf  = buf_ + i_part * per_part_;
+        for (size_t ir = 0; ir < n_run_; ++ir) {
+            std::memcpy(slab + ir * stride_ * blen_, buf + ir * blen_, blen_ * sizeof(double));
+        }
+    }
+}
+void BwPartDtype::Recv_StartPostCompute() {
+#pragma omp barrier
+#pragma omp master
+    {
+        MPI_Wait(&rqst_, MPI_STATUS_IGNORE);
+    }
+}
+
+void BwPartDtype::RequestCleanup(TestPartInfo* info) {
+    MPI_Request_free(&rqst_);
+    if (method_ == part_strided_dtype) {
+        MPI_Type_free(&dtype_);
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef BW_PART_DTYPE_HPP_
+#define BW_PART_DTYPE_HPP_
+#include <vector>
+
+#include "mpi.h"
+#include "part_registry.hpp"
+#include "test_part_bw.hpp"
+
+// part_arg_t + the length of the contiguous runs + the distance between two runs, in runs
+using part_dtype_arg_t = test::merge<part_arg_t, std::tuple<int, int>>::type;
+
+// how a strided partition is exchanged
+enum part_strided_t {
+    part_strided_dtype = 0,  // MPI_Psend_init/MPI_Precv_init with one derived datatype per partition
+    part_strided_pack  = 1,  // each thread packs (unpacks) its partitions, contiguous partitions are exchanged
+};
+
+/* partitioned communication of non-contiguous data, e.g. the face of a 3D halo where each partition is a z-slab.
+ * The data lives in a strided user array: a partition of per_part doubles is made of runs of dtype_block doubles
+ * spaced by dtype_stride runs and the partitions follow each other (dtype_block = 1 and dtype_stride = n is the
+ * x-face of an n^3 block). If per_part is not a multiple of dtype_block, the runs are reduced to gcd(per_part,dtype_block).
+ * - part_strided_dtype: the partitions are described by an MPI_Type_vector resized to the extent of a slab
+ * - part_strided_pack: the sender packs a partition into the contiguous buffer before MPI_Pready,
+ *   the receiver unpacks it after MPI_Parrived, in the thread owning the partition
+ * The user array is allocated for max_count once, each slab of the largest size being first touched by its thread.
+ * The kernel and consume options still work on the contiguous buffer.
+ */
+class BwPartDtype : public TestPartBw {
+    const int method_;  // see part_strided_t
+    const int block_;   // the length of a run in doubles
+    const int stride_;  // the distance between two runs, in runs
+
+    size_t       per_part_;  // the number of doubles in a partition for the current size
+    size_t       blen_;      // the length of a run for the current size
+    size_t       n_run_;     // the number of runs in a partition
+    double*      usr_;       // the strided user array
+    double*      buf_;       // the contiguous buffer, exchanged by part_strided_pack
+    MPI_Datatype dtype_;     // one partition of the user array, for part_strided_dtype
+    MPI_Request  rqst_;
+
+   public:
+    BwPartDtype() = delete;
+    explicit BwPartDtype(part_dtype_arg_t arg, const int method);
+    ~BwPartDtype() override;
+
+   protected:
+    void FileName(const int len, char* filename) override {
+        const char* name[2] = {"dtype", "pack"};
+        char        subname[512];
+        TestPartBw::FileName(512, subname);
+        snprintf(filename, len, "bw_part_%s_b%d_s%d_%s", name[method_], block_, stride_, subname);
+    }
+
+    void RequestInit(TestPartInfo* info) override;
+    void Send_StartPreCompute() override;
+    void Send_StartPostCompute() override;
+    void Send_Pready(const int i_part) override;
+    void Recv_StartPreCompute() override;
+    void Recv_StartPostCompute() override;
+    void Recv_Pready(const int i_part) override;
+    void RequestCleanup(TestPartInfo* info) override;
+
+   private:
+    // the first element of partition i_part in the user array
+    double* Slab_(const int i_part) const { return usr_ + i_part * n_run_ * stride_ * blen_; }
+};
+
+// the factory of the strategy using the method M
+template <int M>
+TestPartBw* part_new_dtype(const std::vector<int>& arg) {
+    return new BwPartDtype(test::from_vector<part_dtype_arg_t>(arg), M);
+}
+
+#endif
@@ -21,7 +21,7 @@ void BwPartMulti::RequestInit(TestPartInfo* info) {
     for (int ip = 0; ip < n_part; ++ip) {
         MPI_Comm part_comm;
         MPI_Comm_dup(MPI_COMM_WORLD, &part_comm);
-        if (is_sender(rank, comm_size)) {
+        if (IsSender()) {
             MPI_Send_init(info->buf + ip * info->size.per_part, info->size.per_part, MPI_DOUBLE, buddy, tag + ip, part_comm, rqst_ + ip);
         } else {
             MPI_Recv_init(info->buf + ip * info->size.per_part, info->size.per_part, MPI_DOUBLE, buddy, tag + ip, part_comm, rqst_ + ip);
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "bw_part_ratio.hpp"
+
+#include <cstdlib>
+#include <numeric>
+
+BwPartRatio::BwPartRatio(part_ratio_arg_t arg) : TestPartBw(m_head(part_arg_s, arg)) {
+    m_info(arg);
+    const int ratio = std::get<part_arg_s + 0>(arg);
+    m_assert(ratio != 0, "the ratio = %d must not be 0", ratio);
+
+    // every partition of the coarser side must group the same number of partitions
+    const int group = std::gcd(n_part, std::abs(ratio));
+    n_send_         = (ratio > 0) ? n_part : n_part / group;
+    n_recv_         = (ratio > 0) ? n_part / group : n_part;
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (!rank && group != std::abs(ratio)) {
+        m_log("warning: %d parts cannot be grouped by %d, the ratio is reduced to %d", n_part, std::abs(ratio), group);
+    }
+}
+
+void BwPartRatio::RequestInit(TestPartInfo* info) {
+    int rank, comm_size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
+
+    // tag = 0 is already used
+    const int tag   = 1;
+    const int buddy = get_friend(rank, comm_size);
+
+    if (IsSender()) {
+        const int group = n_part / n_send_;
+        count_          = std::vector<std::atomic<int>>(n_send_);
+        MPI_Psend_init(info->buf, n_send_, group * info->size.per_part, MPI_DOUBLE, buddy, tag, MPI_COMM_WORLD,
+                       MPI_INFO_NULL, &rqst_);
+    } else {
+        const int group = n_part / n_recv_;
+        count_          = std::vector<std::atomic<int>>(n_recv_);
+        MPI_Precv_init(info->buf, n_recv_, group * info->size.per_part, MPI_DOUBLE, buddy, tag, MPI_COMM_WORLD,
+                       MPI_INFO_NULL, &rqst_);
+    }
+    for (auto& count : count_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+void BwPartRatio::Send_StartPreCompute() {
+#pragma omp master
+    {
+        MPI_Start(&rqst_);
+    }
+#pragma omp barrier
+}
+void BwPartRatio::Send_Pready(const int i_part) {
+    const int group = n_part / n_send_;
+    if (group == 1) {
+        MPI_Pready(i_part, rqst_);
+        return;
+    }
+    // the last ready partition of the group marks it ready, the counter is reset for the next iteration
+    const int ig = i_part / group;
+    if (count_[ig].fetch_add(1, std::memory_order_acq_rel) == (group - 1)) {
+        count_[ig].store(0, std::memory_order_relaxed);
+        MPI_Pready(ig, rqst_);
+    }
+}
+void BwPartRatio::Send_StartPostCompute() {
+#pragma omp barrier
+#pragma omp master
+    {
+        MPI_Wait(&rqst_, MPI_STATUS_IGNORE);
+    }
+}
+
+void BwPartRatio::Recv_StartPreCompute() {
+#pragma omp master
+    {
+        for (auto& count : count_) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        MPI_Start(&rqst_);
+    }
+#pragma omp barrier
+}
+void BwPartRatio::Recv_Pready(const int i_part) {
+    const int group = n_part / n_recv_;
+    const int ig    = i_part / group;
+    // the thread owning the first partition of the group polls it, the other ones wait for that thread.
+    // the first partition is owned by the same or by a previous thread, which cannot wait on us
+    if (i_part == ig * group) {
+        int flag;
+        do {
+            MPI_Parrived(rqst_, ig, &flag);
+        } while (!flag);
+        count_[ig].store(1, std::memory_order_release);
+    } else {
+        while (count_[ig].load(std::memory_order_acquire) == 0) {
+        }
+    }
+}
+void BwPartRatio::Recv_StartPostCompute() {
+#pragma omp barrier
+#pragma omp master
+    {
+        MPI_Wait(&rqst_, MPI_STATUS_IGNORE);
+    }
+}
+
+void BwPartRatio::RequestCleanup(TestPartInfo* info) {
+    MPI_Request_free(&rqst_);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef BW_PART_RATIO_HPP_
+#define BW_PART_RATIO_HPP_
+#include <atomic>
+#include <vector>
+
+#include "mpi.h"
+#include "test_part_bw.hpp"
+
+// part_arg_t + the ratio of the sender to the receiver partitions
+using part_ratio_arg_t = test::merge<part_arg_t, std::tuple<int>>::type;
+
+/* partitioned communication with different partition counts on each side (allowed by MPI-4):
+ * a ratio r > 0 gives r sender partitions for one receiver partition (fine producer, coarse consumer),
+ * a ratio r < 0 gives one sender partition for |r| receiver partitions.
+ * The threads work on the n_part partitions of the finer side, a partition of the coarser side groups |r| of them:
+ * - on the sender, the last thread marking a partition of the group ready calls MPI_Pready
+ * - on the receiver, the thread owning the first partition of the group waits for its arrival
+ * The group is reduced to gcd(n_part, |r|) if n_part cannot be divided.
+ */
+class BwPartRatio : public TestPartBw {
+    int n_send_;  // the number of partitions of the sender
+    int n_recv_;  // the number of partitions of the receiver
+
+    MPI_Request                   rqst_;
+    std::vector<std::atomic<int>> count_;  // the number of ready (sender) or arrived (receiver) partitions of a group
+
+   public:
+    BwPartRatio() = delete;
+    explicit BwPartRatio(part_ratio_arg_t arg);
+
+   protected:
+    void FileName(const int len, char* filename) override {
+        char subname[512];
+        TestPartBw::FileName(512, subname);
+        snprintf(filename, len, "bw_part%dto%d_%s", m_max(1, n_send_ / n_recv_), m_max(1, n_recv_ / n_send_), subname);
+    }
+
+    void RequestInit(TestPartInfo* info) override;
+    void Send_StartPreCompute() override;
+    void Send_StartPostCompute() override;
+    void Send_Pready(const int i_part) override;
+    void Recv_StartPreCompute() override;
+    void Recv_StartPostCompute() override;
+    void Recv_Pready(const int i_part) override;
+    void RequestCleanup(TestPartInfo* info) override;
+};
+
+#endif
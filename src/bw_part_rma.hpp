@@ -7,6 +7,7 @@
 #include "test_part_bw.hpp"
 
 class BwPartRma : public TestPartBw {
+   protected:
     put_info_t* put_info_;
 
    public:
@@ -23,6 +24,15 @@ class BwPartRma : public TestPartBw {
         snprintf(filename, len, "bw_rma_%s", subname);
     }
 
+    // the receiver is notified at the completion only
+    bool PartArrival() const override { return false; }
+
+    // the partition lands in the window of the thread which put it
+    double* RecvPart(const TestPartInfo* info, const int i_part) override {
+        const size_t offset = i_part * info->size.per_part;
+        return (double*)put_info_[i_part / n_partpt].local + offset;
+    }
+
     void RequestInit(TestPartInfo* info) override;
     void Send_StartPreCompute() override;
     void Send_StartPostCompute() override;
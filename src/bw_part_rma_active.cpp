@@ -4,6 +4,17 @@
  */
 #include "bw_part_rma_active.hpp"
 #include "mpi.h"
+#include "rma_win.hpp"
+
+// free the windows, the comms and the groups
+static void rma_active_win_free(put_info_t* info, const int n_info, const bool sender) {
+    for (int ip = 0; ip < n_info; ++ip) {
+        part_win_free(sender, info + ip);
+        MPI_Comm_free(&(info[ip].comm));
+        MPI_Group_free(&(info[ip].group));
+    }
+    free(info);
+}
 
 void BwPartRmaActive::RequestInit(TestPartInfo* info) {
     int rank, comm_size;
@@ -11,7 +22,16 @@ void BwPartRmaActive::RequestInit(TestPartInfo* info) {
     MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
 
     const int buddy = get_friend(rank, comm_size);
-    const int n_threads = omp_get_max_threads();
+    // reuse the cached windows, only the count changes
+    if (WinCache()) {
+        put_info_ = PartWinCache::Find(WinKey("rma_active"), info->buf, WinSize(info), n_threads);
+        if (put_info_) {
+            for (int ip = 0; ip < n_threads; ++ip) {
+                put_info_[ip].count = info->size.per_part;
+            }
+            return;
+        }
+    }
     put_info_ = (put_info_t*)malloc(n_threads * sizeof(put_info_t));
 
     // get the new group and the new comm associated to the send/recv ranks only!
@@ -44,23 +64,20 @@ void BwPartRmaActive::RequestInit(TestPartInfo* info) {
         MPI_Info_create(&win_info);
         MPI_Info_set(win_info, "same_disp_unit", "true");
         MPI_Comm_dup(win_comm, &(put_info_[ip].comm));
-        if (is_sender(rank, comm_size)) {
-            // size is 0 on the sender, address can then be NULL
-            MPI_Win_create(NULL, 0, 1, win_info, put_info_[ip].comm, &(put_info_[ip].win));
-        } else {
-            MPI_Aint win_size = info->size.per_part * n_part * sizeof(double);
-            MPI_Win_create(put_info_[ip].buf, win_size, 1, win_info, put_info_[ip].comm, &(put_info_[ip].win));
-        }
+        MPI_Aint win_size = WinSize(info);
+        part_win_create(opt_.win_flavor, IsSender(), put_info_[ip].buf, win_size, win_info, &(put_info_[ip]));
     }
     /* free the groups, comms etc */
     MPI_Group_free(&comm_group);
     MPI_Group_free(&win_group);
     MPI_Comm_free(&win_comm);
+    if (WinCache()) {
+        PartWinCache::Store(WinKey("rma_active"), put_info_, n_threads, info->buf, WinSize(info), IsSender(), rma_active_win_free);
+    }
 }
 
 void BwPartRmaActive::Send_StartPreCompute() {
     // sender starts an access epoch
-    const int n_threads = omp_get_max_threads();
 #pragma omp barrier
 #pragma omp for schedule(static) nowait
     for (int ip = 0; ip < n_threads; ++ip) {
@@ -75,11 +92,10 @@ void BwPartRmaActive::Send_Pready(const int i_part) {
     int      count = info->count;
     MPI_Aint disp  = info->count * i_part * sizeof(double);
     void*    buf   = (char*)info->buf + disp;
-    MPI_Put(buf, count, MPI_DOUBLE, info->target_rank, disp, info->count, MPI_DOUBLE, info->win);
+    MPI_Put(buf, count, MPI_DOUBLE, info->target_rank, info->disp + disp, info->count, MPI_DOUBLE, info->win);
 }
 void BwPartRmaActive::Send_StartPostCompute() {
     // close the access epoch
-    const int n_threads = omp_get_max_threads();
 #pragma omp for schedule(static) nowait
     for (int ip = 0; ip < n_threads; ++ip) {
         put_info_t* info = put_info_ + ip;
@@ -90,7 +106,6 @@ void BwPartRmaActive::Send_StartPostCompute() {
 
 void BwPartRmaActive::Recv_StartPreCompute() {
     // start the exposure epoch
-    const int n_threads = omp_get_max_threads();
 #pragma omp barrier
 #pragma omp for schedule(static) nowait
     for (int ip = 0; ip < n_threads; ++ip) {
@@ -100,7 +115,6 @@ void BwPartRmaActive::Recv_StartPreCompute() {
 }
 void BwPartRmaActive::Recv_Pready(const int i_part) {}
 void BwPartRmaActive::Recv_StartPostCompute() {
-    const int n_threads = omp_get_max_threads();
 #pragma omp for schedule(static) nowait
     for (int ip = 0; ip < n_threads; ++ip) {
         put_info_t* info = put_info_ + ip;
@@ -110,11 +124,8 @@ void BwPartRmaActive::Recv_StartPostCompute() {
 }
 
 void BwPartRmaActive::RequestCleanup(TestPartInfo* info) {
-    const int n_threads = omp_get_max_threads();
-    for (int ip = 0; ip < n_threads; ++ip) {
-        MPI_Win_free(&(put_info_[ip].win));
-        MPI_Comm_free(&(put_info_[ip].comm));
-        MPI_Group_free(&(put_info_[ip].group));
+    // the cached windows are freed by the cache
+    if (!WinCache()) {
+        rma_active_win_free(put_info_, n_threads, IsSender());
     }
-    free(put_info_);
 }
@@ -4,6 +4,16 @@
  */
 #include "bw_part_rma_fence.hpp"
 #include "mpi.h"
+#include "rma_win.hpp"
+
+// free the windows and the comms
+static void rma_fence_win_free(put_info_t* info, const int n_info, const bool sender) {
+    for (int ip = 0; ip < n_info; ++ip) {
+        part_win_free(sender, info + ip);
+        MPI_Comm_free(&(info[ip].comm));
+    }
+    free(info);
+}
 
 void BwPartRmaFence::RequestInit(TestPartInfo* info) {
     int rank, comm_size;
@@ -11,7 +21,16 @@ void BwPartRmaFence::RequestInit(TestPartInfo* info) {
     MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
 
     const int buddy     = get_friend(rank, comm_size);
-    const int n_threads = omp_get_max_threads();
+    // reuse the cached windows, only the count changes
+    if (WinCache()) {
+        put_info_ = PartWinCache::Find(WinKey("rma_fence"), info->buf, WinSize(info), n_threads);
+        if (put_info_) {
+            for (int ip = 0; ip < n_threads; ++ip) {
+                put_info_[ip].count = info->size.per_part;
+            }
+            return;
+        }
+    }
     put_info_           = (put_info_t*)malloc(n_threads * sizeof(put_info_t));
 
     // get the new group and the new comm associated to the send/recv ranks only!
@@ -41,24 +60,21 @@ void BwPartRmaFence::RequestInit(TestPartInfo* info) {
         MPI_Info_create(&win_info);
         MPI_Info_set(win_info, "same_disp_unit", "true");
         MPI_Comm_dup(win_comm, &(put_info_[ip].comm));
-        if (is_sender(rank, comm_size)) {
-            // size is 0 on the sender, address can then be NULL
-            MPI_Win_create(NULL, 0, 1, win_info, put_info_[ip].comm, &(put_info_[ip].win));
-        } else {
-            MPI_Aint win_size = info->size.per_part * n_part * sizeof(double);
-            MPI_Win_create(put_info_[ip].buf, win_size, 1, win_info, put_info_[ip].comm, &(put_info_[ip].win));
-        }
+        MPI_Aint win_size = WinSize(info);
+        part_win_create(opt_.win_flavor, IsSender(), put_info_[ip].buf, win_size, win_info, &(put_info_[ip]));
         MPI_Win_fence(0,put_info_[ip].win);
     }
     /* free the groups, comms etc */
     MPI_Group_free(&comm_group);
     MPI_Group_free(&win_group);
     MPI_Comm_free(&win_comm);
+    if (WinCache()) {
+        PartWinCache::Store(WinKey("rma_fence"), put_info_, n_threads, info->buf, WinSize(info), IsSender(), rma_fence_win_free);
+    }
 }
 
 void BwPartRmaFence::Send_StartPreCompute() {
     // close the access epoch
-    const int n_threads = omp_get_max_threads();
 #pragma omp barrier
 #pragma omp for schedule(static) nowait
     for (int ip = 0; ip < n_threads; ++ip) {
@@ -73,10 +89,9 @@ void BwPartRmaFence::Send_Pready(const int i_part) {
     int      count = info->count;
     MPI_Aint disp  = info->count * i_part * sizeof(double);
     void*    buf   = (char*)info->buf + disp;
-    MPI_Put(buf, count, MPI_DOUBLE, info->target_rank, disp, info->count, MPI_DOUBLE, info->win);
+    MPI_Put(buf, count, MPI_DOUBLE, info->target_rank, info->disp + disp, info->count, MPI_DOUBLE, info->win);
 }
 void BwPartRmaFence::Send_StartPostCompute() {
-    const int n_threads = omp_get_max_threads();
 #pragma omp for schedule(static) nowait
     for (int ip = 0; ip < n_threads; ++ip) {
         put_info_t* info = put_info_ + ip;
@@ -86,7 +101,6 @@ void BwPartRmaFence::Send_StartPostCompute() {
 }
 
 void BwPartRmaFence::Recv_StartPreCompute() {
-    const int n_threads = omp_get_max_threads();
 #pragma omp barrier
 #pragma omp for schedule(static) nowait
     for (int ip = 0; ip < n_threads; ++ip) {
@@ -97,7 +111,6 @@ void BwPartRmaFence::Recv_StartPreCompute() {
 void BwPartRmaFence::Recv_Pready(const int i_part) {
 }
 void BwPartRmaFence::Recv_StartPostCompute() {
-    const int n_threads = omp_get_max_threads();
 #pragma omp for schedule(static) nowait
     for (int ip = 0; ip < n_threads; ++ip) {
         put_info_t* info = put_info_ + ip;
@@ -107,10 +120,8 @@ void BwPartRmaFence::Recv_StartPostCompute() {
 }
 
 void BwPartRmaFence::RequestCleanup(TestPartInfo* info) {
-    const int n_threads = omp_get_max_threads();
-    for (int ip = 0; ip < n_threads; ++ip) {
-        MPI_Win_free(&(put_info_[ip].win));
-        MPI_Comm_free(&(put_info_[ip].comm));
+    // the cached windows are freed by the cache
+    if (!WinCache()) {
+        rma_fence_win_free(put_info_, n_threads, IsSender());
     }
-    free(put_info_);
 }
@@ -22,6 +22,15 @@ class BwPartRmaFence : public TestPartBw {
         snprintf(filename, len, "bw_rma_fence_%s", subname);
     }
 
+    // the receiver is notified at the completion only
+    bool PartArrival() const override { return false; }
+
+    // the partition lands in the window of the thread which put it
+    double* RecvPart(const TestPartInfo* info, const int i_part) override {
+        const size_t offset = i_part * info->size.per_part;
+        return (double*)put_info_[i_part / n_partpt].local + offset;
+    }
+
     void RequestInit(TestPartInfo* info) override;
     void Send_StartPreCompute() override;
     void Send_StartPostCompute() override;
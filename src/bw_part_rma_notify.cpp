@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "bw_part_rma_notify.hpp"
+#include "mpi.h"
+
+void BwPartRmaNotify::RequestInit(TestPartInfo* info) {
+    BwPartRma::RequestInit(info);
+
+    // the flags are exposed on the receiver only
+    const MPI_Aint flag_size = IsSender() ? 0 : n_part * sizeof(int);
+    MPI_Alloc_mem(m_max(flag_size, (MPI_Aint)sizeof(int)), MPI_INFO_NULL, &flag_);
+    for (int ip = 0; ip < n_part; ++ip) {
+        flag_[ip] = 0;
+    }
+    epoch_ = 0;
+    self_  = 1 - put_info_[0].target_rank;
+
+    flag_win_ = (MPI_Win*)malloc(n_threads * sizeof(MPI_Win));
+    for (int ith = 0; ith < n_threads; ++ith) {
+        // the windows use the comms of the data windows, one per thread
+        MPI_Win_create(flag_, flag_size, sizeof(int), MPI_INFO_NULL, put_info_[ith].comm, flag_win_ + ith);
+        // the receiver needs a passive epoch on its own flags to synchronize them
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, flag_win_[ith]);
+    }
+}
+
+void BwPartRmaNotify::Send_StartPreCompute() {
+#pragma omp master
+    { epoch_++; }
+    // the barrier is done in BwPartRma
+    BwPartRma::Send_StartPreCompute();
+}
+void BwPartRmaNotify::Send_Pready(const int i_part) {
+    const int   ith  = omp_get_thread_num();
+    put_info_t* info = put_info_ + ith;
+
+    // the data must be complete on the target before the notification
+    BwPartRma::Send_Pready(i_part);
+    MPI_Win_flush(info->target_rank, info->win);
+
+    const int one = 1;
+    switch (method_) {
+        case (part_notify_flag): {
+            MPI_Put(&epoch_, 1, MPI_INT, info->target_rank, i_part, 1, MPI_INT, flag_win_[ith]);
+        } break;
+        case (part_notify_acc): {
+            MPI_Accumulate(&one, 1, MPI_INT, info->target_rank, i_part, 1, MPI_INT, MPI_SUM, flag_win_[ith]);
+        } break;
+        case (part_notify_fop): {
+            int prev;
+            MPI_Fetch_and_op(&one, &prev, MPI_INT, info->target_rank, i_part, MPI_SUM, flag_win_[ith]);
+            MPI_Win_flush(info->target_rank, flag_win_[ith]);
+        } break;
+        default:
+            m_assert(false, "unknown notification method %d", method_);
+    }
+}
+void BwPartRmaNotify::Send_StartPostCompute() {
+    // the notifications which are not flushed yet are completed with the data
+#pragma omp for schedule(static) nowait
+    for (int ith = 0; ith < n_threads; ++ith) {
+        MPI_Win_flush(put_info_[ith].target_rank, flag_win_[ith]);
+    }
+    BwPartRma::Send_StartPostCompute();
+}
+
+void BwPartRmaNotify::Recv_StartPreCompute() {
+#pragma omp master
+    { epoch_++; }
+    // the barrier is done in BwPartRma
+    BwPartRma::Recv_StartPreCompute();
+}
+void BwPartRmaNotify::Recv_Pready(const int i_part) {
+    const int ith = omp_get_thread_num();
+    if (method_ == part_notify_flag) {
+        // the flag is written by an MPI_Put: read it from memory once the window is synchronized
+        volatile int* flag = flag_ + i_part;
+        while (*flag < epoch_) {
+            MPI_Win_sync(flag_win_[ith]);
+        }
+    } else {
+        // the counter is written by atomic operations: read it with an atomic operation
+        int value = 0;
+        while (value < epoch_) {
+            MPI_Fetch_and_op(NULL, &value, MPI_INT, self_, i_part, MPI_NO_OP, flag_win_[ith]);
+            MPI_Win_flush(self_, flag_win_[ith]);
+        }
+    }
+}
+
+void BwPartRmaNotify::RequestCleanup(TestPartInfo* info) {
+    for (int ith = 0; ith < n_threads; ++ith) {
+        MPI_Win_unlock_all(flag_win_[ith]);
+        MPI_Win_free(flag_win_ + ith);
+    }
+    free(flag_win_);
+    MPI_Free_mem(flag_);
+    BwPartRma::RequestCleanup(info);
+}
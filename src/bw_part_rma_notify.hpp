@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef BW_PART_RMA_NOTIFY_HPP_
+#define BW_PART_RMA_NOTIFY_HPP_
+#include <vector>
+
+#include "bw_part_rma.hpp"
+#include "part_registry.hpp"
+
+// how the arrival of a partition is signaled to the target
+enum part_notify_t {
+    part_notify_flag = 0,  // MPI_Put of the epoch in the flag of the partition
+    part_notify_acc  = 1,  // MPI_Accumulate(MPI_SUM) of 1 in the counter of the partition
+    part_notify_fop  = 2,  // MPI_Fetch_and_op(MPI_SUM) of 1 in the counter of the partition, flushed right away
+};
+
+/* passive target RMA (see BwPartRma) with a notification of every partition.
+ * The data is flushed before the notification is issued so that a notified partition is complete on the target.
+ * The notifications go to a second set of windows (one per thread) holding one integer per partition,
+ * the receiver polls it in Recv_Pready, like MPI_Parrived in BwPart.
+ */
+class BwPartRmaNotify : public BwPartRma {
+    const int method_;  // see part_notify_t
+
+    int      epoch_;     // the number of iterations started, the value of the flags once the partitions have arrived
+    int*     flag_;      // the flag of every partition on the receiver
+    MPI_Win* flag_win_;  // one window per thread exposing the flags
+    int      self_;      // our rank in the window
+
+   public:
+    BwPartRmaNotify() = delete;
+    explicit BwPartRmaNotify(part_arg_t arg, const int method) : BwPartRma(arg), method_{method} {};
+
+   protected:
+    void FileName(const int len, char* filename) override {
+        const char* name[3] = {"flag", "acc", "fop"};
+        char        subname[512];
+        TestPartBw::FileName(512, subname);
+        snprintf(filename, len, "bw_rma_notify_%s_%s", name[method_], subname);
+    }
+
+    // the receiver is notified of every partition
+    bool PartArrival() const override { return true; }
+
+    void RequestInit(TestPartInfo* info) override;
+    void Send_StartPreCompute() override;
+    void Send_StartPostCompute() override;
+    void Send_Pready(const int i_part) override;
+    void Recv_StartPreCompute() override;
+    void Recv_Pready(const int i_part) override;
+    void RequestCleanup(TestPartInfo* info) override;
+};
+
+// the factory of the strategy using the notification method M
+template <int M>
+TestPartBw* part_new_notify(const std::vector<int>& arg) {
+    return new BwPartRmaNotify(test::from_vector<part_arg_t>(arg), M);
+}
+
+#endif
@@ -4,6 +4,17 @@
  */
 #include "bw_part_rma_single.hpp"
 #include "mpi.h"
+#include "rma_win.hpp"
+
+// free the window and the comm
+static void rma_single_win_free(put_info_t* info, const int n_info, const bool sender) {
+    if (sender) {
+        MPI_Win_unlock(info->target_rank, info->win);
+    }
+    part_win_free(sender, info);
+    MPI_Comm_free(&(info->comm));
+    free(info);
+}
 
 void BwPartRmaSingle::RequestInit(TestPartInfo* info) {
     int rank, comm_size;
@@ -11,6 +22,14 @@ void BwPartRmaSingle::RequestInit(TestPartInfo* info) {
     MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
 
     const int buddy = get_friend(rank, comm_size);
+    // reuse the cached windows, only the count changes
+    if (WinCache()) {
+        put_info_ = PartWinCache::Find(WinKey("rma_single"), info->buf, WinSize(info), 1);
+        if (put_info_) {
+            put_info_->count = info->size.per_part;
+            return;
+        }
+    }
     put_info_       = (put_info_t*)malloc(sizeof(put_info_t));
 
     // get the new group and the new comm associated to the send/recv ranks only!
@@ -38,17 +57,17 @@ void BwPartRmaSingle::RequestInit(TestPartInfo* info) {
     MPI_Info win_info;
     MPI_Info_create(&win_info);
     MPI_Info_set(win_info, "same_disp_unit", "true");
-    if (is_sender(rank, comm_size)) {
-        // size is 0 on the sender, address can then be NULL
-        MPI_Win_create(NULL, 0, 1, win_info, put_info_->comm, &(put_info_->win));
+    MPI_Aint win_size = WinSize(info);
+    part_win_create(opt_.win_flavor, IsSender(), put_info_->buf, win_size, win_info, put_info_);
+    if (IsSender()) {
         MPI_Win_lock(MPI_LOCK_SHARED, put_info_->target_rank, MPI_MODE_NOCHECK, put_info_->win);
-    } else {
-        MPI_Aint win_size = info->size.per_part * n_part * sizeof(double);
-        MPI_Win_create(put_info_->buf, win_size, 1, win_info, put_info_->comm, &(put_info_->win));
     }
     /* free the groups, comms etc */
     MPI_Group_free(&comm_group);
     MPI_Group_free(&win_group);
+    if (WinCache()) {
+        PartWinCache::Store(WinKey("rma_single"), put_info_, 1, info->buf, WinSize(info), IsSender(), rma_single_win_free);
+    }
 }
 
 void BwPartRmaSingle::Send_StartPreCompute() {
@@ -66,7 +85,7 @@ void BwPartRmaSingle::Send_Pready(const int i_part) {
     put_info_t* info = put_info_;
     MPI_Aint    disp = i_part * info->count * sizeof(double);
     void*       buf  = ((char*)info->buf) + disp;
-    MPI_Put(buf, info->count, MPI_DOUBLE, info->target_rank, disp, info->count, MPI_DOUBLE, info->win);
+    MPI_Put(buf, info->count, MPI_DOUBLE, info->target_rank, info->disp + disp, info->count, MPI_DOUBLE, info->win);
 }
 void BwPartRmaSingle::Send_StartPostCompute() {
 #pragma omp barrier
@@ -101,13 +120,8 @@ void BwPartRmaSingle::Recv_StartPostCompute() {
 }
 
 void BwPartRmaSingle::RequestCleanup(TestPartInfo* info) {
-    int rank, comm_size;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
-    if (is_sender(rank, comm_size)) {
-        MPI_Win_unlock(put_info_->target_rank, put_info_->win);
+    // the cached window is freed by the cache
+    if (!WinCache()) {
+        rma_single_win_free(put_info_, 1, IsSender());
     }
-    MPI_Win_free(&(put_info_->win));
-    MPI_Comm_free(&(put_info_->comm));
-    free(put_info_);
 }
@@ -22,6 +22,14 @@ class BwPartRmaSingle : public TestPartBw {
         snprintf(filename, len, "bw_rma_single_%s", subname);
     }
 
+    // the receiver is notified at the completion only
+    bool PartArrival() const override { return false; }
+
+    // the partition lands in the memory exposed by the window
+    double* RecvPart(const TestPartInfo* info, const int i_part) override {
+        return (double*)put_info_->local + i_part * info->size.per_part;
+    }
+
     void RequestInit(TestPartInfo* info) override;
     void Send_StartPreCompute() override;
     void Send_StartPostCompute() override;
@@ -4,6 +4,15 @@
  */
 #include "bw_part_rma_single_active.hpp"
 #include "mpi.h"
+#include "rma_win.hpp"
+
+// free the window, the comm and the group
+static void rma_single_active_win_free(put_info_t* info, const int n_info, const bool sender) {
+    part_win_free(sender, info);
+    MPI_Comm_free(&(info->comm));
+    MPI_Group_free(&(info->group));
+    free(info);
+}
 
 void BwPartRmaSingleActive::RequestInit(TestPartInfo* info) {
     int rank, comm_size;
@@ -11,6 +20,16 @@ void BwPartRmaSingleActive::RequestInit(TestPartInfo* info) {
     MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
 
     const int buddy = get_friend(rank, comm_size);
+    // reuse the cached window, only the count changes
+    if (WinCache()) {
+        put_info_ = PartWinCache::Find(WinKey("rma_single_active"), info->buf, WinSize(info), 1);
+        if (put_info_) {
+            put_info_->count = info->size.per_part;
+            return;
+        }
+    }
+    put_info_ = (put_info_t*)malloc(sizeof(put_info_t));
+
     // get the new group and the new comm associated to the send/recv ranks only!
     MPI_Group comm_group;
     MPI_Comm_group(MPI_COMM_WORLD, &comm_group);
@@ -29,51 +48,51 @@ void BwPartRmaSingleActive::RequestInit(TestPartInfo* info) {
     int target_rank;
     MPI_Group_translate_ranks(comm_group, 1, &buddy, win_group, &target_rank);
 
-    put_info_.target_rank = target_rank;
-    put_info_.count       = info->size.per_part;
-    put_info_.buf         = info->buf;
+    put_info_->target_rank = target_rank;
+    put_info_->count       = info->size.per_part;
+    put_info_->buf         = info->buf;
 
     // create the communicator group for the active sync
-    MPI_Group_incl(comm_group, 1, &buddy, &(put_info_.group));
+    MPI_Group_incl(comm_group, 1, &buddy, &(put_info_->group));
 
     // duplicate the comms to use different VCIs, each window on a different comm
     MPI_Info win_info;
     MPI_Info_create(&win_info);
     MPI_Info_set(win_info, "same_disp_unit", "true");
-    MPI_Comm_dup(win_comm, &(put_info_.comm));
-    if (is_sender(rank, comm_size)) {
-        // size is 0 on the sender, address can then be NULL
-        MPI_Win_create(NULL, 0, 1, win_info, put_info_.comm, &(put_info_.win));
-    } else {
-        MPI_Aint win_size = info->size.per_part * sizeof(double);
-        MPI_Win_create(put_info_.buf, win_size, 1, win_info, put_info_.comm, &(put_info_.win));
-    }
+    MPI_Comm_dup(win_comm, &(put_info_->comm));
+    // every partition is put at its place in the window, read from there by RecvPart()
+    MPI_Aint win_size = WinSize(info);
+    part_win_create(opt_.win_flavor, IsSender(), put_info_->buf, win_size, win_info, put_info_);
 
     /* free the groups, comms etc */
     MPI_Group_free(&comm_group);
     MPI_Group_free(&win_group);
     MPI_Comm_free(&win_comm);
+    if (WinCache()) {
+        PartWinCache::Store(WinKey("rma_single_active"), put_info_, 1, info->buf, WinSize(info), IsSender(),
+                            rma_single_active_win_free);
+    }
 }
 
 void BwPartRmaSingleActive::Send_StartPreCompute() {
 #pragma omp master
     {
         // sender starts an access epoch
-        MPI_Win_start(put_info_.group, 0, put_info_.win);
+        MPI_Win_start(put_info_->group, 0, put_info_->win);
     }
 #pragma omp barrier
 }
 void BwPartRmaSingleActive::Send_Pready(const int i_part) {
-    MPI_Aint disp = i_part * put_info_.count * sizeof(double);
-    void*    buf  = ((char*)put_info_.buf) + disp;
-    MPI_Put(buf, put_info_.count, MPI_DOUBLE, put_info_.target_rank, 0, put_info_.count, MPI_DOUBLE, put_info_.win);
+    MPI_Aint disp = i_part * put_info_->count * sizeof(double);
+    void*    buf  = ((char*)put_info_->buf) + disp;
+    MPI_Put(buf, put_info_->count, MPI_DOUBLE, put_info_->target_rank, put_info_->disp + disp, put_info_->count, MPI_DOUBLE, put_info_->win);
 }
 void BwPartRmaSingleActive::Send_StartPostCompute() {
 #pragma omp barrier
 #pragma omp master
     {
         // close the access epoch
-        MPI_Win_complete(put_info_.win);
+        MPI_Win_complete(put_info_->win);
     }
 }
 
@@ -81,7 +100,7 @@ void BwPartRmaSingleActive::Recv_StartPreCompute() {
 #pragma omp master
     {
         // start the exposure epoch
-        MPI_Win_post(put_info_.group, 0, put_info_.win);
+        MPI_Win_post(put_info_->group, 0, put_info_->win);
     }
 #pragma omp barrier
 }
@@ -91,12 +110,13 @@ void BwPartRmaSingleActive::Recv_StartPostCompute() {
 #pragma omp barrier
 #pragma omp master
     {
-        MPI_Win_wait(put_info_.win);
+        MPI_Win_wait(put_info_->win);
     }
 }
 
 void BwPartRmaSingleActive::RequestCleanup(TestPartInfo* info) {
-    MPI_Win_free(&(put_info_.win));
-    MPI_Comm_free(&(put_info_.comm));
-    MPI_Group_free(&(put_info_.group));
+    // the cached window is freed by the cache
+    if (!WinCache()) {
+        rma_single_active_win_free(put_info_, 1, IsSender());
+    }
 }
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "bw_part_shm.hpp"
+
+#include <cstring>
+#include <new>
+
+#include "mpi.h"
+
+void BwPartShm::RequestInit(TestPartInfo* info) {
+    int rank, comm_size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
+    const int buddy = get_friend(rank, comm_size);
+
+    // the pair must share the node, the comm of the pair is made of the two ranks of the node
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+    MPI_Group world_group, node_group;
+    MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+    MPI_Comm_group(node_comm, &node_group);
+    int node_buddy;
+    MPI_Group_translate_ranks(world_group, 1, &buddy, node_group, &node_buddy);
+    m_assert(node_buddy != MPI_UNDEFINED, "the ranks %d and %d must be on the same node", rank, buddy);
+    MPI_Comm_split(node_comm, m_min(rank, buddy), rank, &pair_comm_);
+    MPI_Group_free(&world_group);
+    MPI_Group_free(&node_group);
+    MPI_Comm_free(&node_comm);
+
+    // the receiver owns the segment: the flags followed by the data
+    count_                   = info->size.per_part;
+    const size_t   flag_size = n_part * sizeof(flag_t);
+    const MPI_Aint win_size  = IsSender() ? 0 : flag_size + info->size.per_rank * sizeof(double);
+    void*          segment;
+    MPI_Win_allocate_shared(win_size, 1, MPI_INFO_NULL, pair_comm_, &segment, &win_);
+    if (IsSender()) {
+        const int recv_rank = (rank < buddy) ? 1 : 0;
+        MPI_Aint  size;
+        int       disp_unit;
+        MPI_Win_shared_query(win_, recv_rank, &size, &disp_unit, &segment);
+    } else {
+        for (int ip = 0; ip < n_part; ++ip) {
+            new (((flag_t*)segment) + ip) flag_t;
+            ((flag_t*)segment)[ip].epoch.store(0, std::memory_order_relaxed);
+        }
+        part_first_touch((double*)((char*)segment + flag_size), info->size.per_part, n_part, 0.0);
+    }
+    flag_  = (flag_t*)segment;
+    data_  = (double*)((char*)segment + flag_size);
+    epoch_ = 0;
+    buf_   = info->buf;
+    // the flags are initialized before the sender uses them
+    MPI_Barrier(pair_comm_);
+}
+
+void BwPartShm::Send_StartPreCompute() {
+#pragma omp master
+    { epoch_++; }
+#pragma omp barrier
+}
+void BwPartShm::Send_Pready(const int i_part) {
+    memcpy(data_ + i_part * count_, buf_ + i_part * count_, count_ * sizeof(double));
+    flag_[i_part].epoch.store(epoch_, std::memory_order_release);
+}
+void BwPartShm::Send_StartPostCompute() {
+#pragma omp barrier
+}
+
+void BwPartShm::Recv_StartPreCompute() {
+#pragma omp master
+    { epoch_++; }
+#pragma omp barrier
+}
+void BwPartShm::Recv_Pready(const int i_part) {
+    while (flag_[i_part].epoch.load(std::memory_order_acquire) < epoch_) {
+    }
+}
+void BwPartShm::Recv_StartPostCompute() {
+#pragma omp barrier
+}
+
+void BwPartShm::RequestCleanup(TestPartInfo* info) {
+    MPI_Win_free(&win_);
+    MPI_Comm_free(&pair_comm_);
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef BW_PART_SHM_HPP_
+#define BW_PART_SHM_HPP_
+#include <atomic>
+
+#include "test_part_bw.hpp"
+
+/* intra-node transfer through a shared-memory window allocated by the receiver.
+ * The sender copies each partition into the segment of the receiver and publishes it with an atomic flag,
+ * the receiver polls the flags and reads the partitions from the segment, without any MPI call in the loop.
+ * The buffer of the test is left untouched: the pong test of the ping-pong has its own segment.
+ * Both ranks of the pair must be on the same node.
+ */
+class BwPartShm : public TestPartBw {
+    // the flag of a partition, on its own cache line
+    typedef struct {
+        std::atomic<int> epoch;
+        char             pad[64 - sizeof(std::atomic<int>)];
+    } flag_t;
+
+    MPI_Comm pair_comm_;
+    MPI_Win  win_;
+    flag_t*  flag_;    // the flags of the partitions in the segment of the receiver
+    double*  data_;    // the data in the segment of the receiver
+    double*  buf_;     // the buffer of the test, copied into the segment by the sender
+    size_t   count_;   // the number of doubles in a partition
+    int      epoch_;   // the number of iterations started, the value of the flags once the partitions have arrived
+
+   public:
+    BwPartShm() = delete;
+    explicit BwPartShm(part_arg_t arg) : TestPartBw(arg) {
+        std::tuple<> v;
+        m_info(v);
+    };
+
+   protected:
+    void FileName(const int len, char* filename) override {
+        char subname[512];
+        TestPartBw::FileName(512, subname);
+        snprintf(filename, len, "bw_shm_%s", subname);
+    }
+
+    // the partitions land in the segment, not in the buffer of the test
+    double* RecvPart(const TestPartInfo* info, const int i_part) override { return data_ + i_part * count_; }
+
+    void RequestInit(TestPartInfo* info) override;
+    void Send_StartPreCompute() override;
+    void Send_StartPostCompute() override;
+    void Send_Pready(const int i_part) override;
+    void Recv_StartPreCompute() override;
+    void Recv_StartPostCompute() override;
+    void Recv_Pready(const int i_part) override;
+    void RequestCleanup(TestPartInfo* info) override;
+};
+
+#endif
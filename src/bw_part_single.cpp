@@ -14,7 +14,7 @@ void BwPartSingle::RequestInit(TestPartInfo* info) {
     const int buddy = get_friend(rank, comm_size);
 
     const int count = info->size.per_part * n_part;
-    if (is_sender(rank, comm_size)) {
+    if (IsSender()) {
         MPI_Send_init(info->buf, count, MPI_DOUBLE, buddy, tag, MPI_COMM_WORLD, &rqst_);
     } else {
         MPI_Recv_init(info->buf, count, MPI_DOUBLE, buddy, tag, MPI_COMM_WORLD, &rqst_);
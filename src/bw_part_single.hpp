@@ -25,6 +25,9 @@ class BwPartSingle : public TestPartBw {
         snprintf(filename,len,"bw_single_%s",subname);
     }
 
+    // the receiver is notified at the completion only
+    bool PartArrival() const override { return false; }
+
     void RequestInit(TestPartInfo* info) override;
     void Send_StartPreCompute() override;
     void Send_StartPostCompute() override;
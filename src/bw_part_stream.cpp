@@ -17,7 +17,6 @@ void BwPartStream::RequestInit(TestPartInfo* info) {
     const int buddy = get_friend(rank, comm_size);
 
     // get one stream per thread
-    const int n_threads = omp_get_max_threads();
     streams_            = (MPIX_Stream*)malloc(n_threads * sizeof(MPIX_Stream));
     thread_comms_       = (MPI_Comm*)malloc(n_threads * sizeof(MPI_Comm));
     MPI_Errhandler err_handler;
@@ -42,7 +41,7 @@ void BwPartStream::RequestInit(TestPartInfo* info) {
     for (int ip = 0; ip < n_part; ++ip) {
         int       ith  = omp_get_thread_num();
         MPI_Comm* comm = thread_comms_ + ith;
-        if (is_sender(rank, comm_size)) {
+        if (IsSender()) {
             MPI_Send_init(info->buf + ip * info->size.per_part, info->size.per_part, MPI_DOUBLE, buddy, tag + ip, *comm, rqst_ + ip);
         } else {
             MPI_Recv_init(info->buf + ip * info->size.per_part, info->size.per_part, MPI_DOUBLE, buddy, tag + ip, *comm, rqst_ + ip);
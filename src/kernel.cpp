@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "kernel.hpp"
+
+#include <cmath>
+
+#include "tools.hpp"
+
+// the 7-point stencil on a block of n[0] x n[1] x n[2], the remaining entries are copied
+static void stencil(const size_t count, double* out, const double* in) {
+    size_t n[3];
+    n[0] = m_max((size_t)1, (size_t)cbrt((double)count));
+    n[1] = n[0];
+    n[2] = count / (n[0] * n[1]);
+    const size_t s[3] = {1, n[0], n[0] * n[1]};
+
+    for (size_t i2 = 0; i2 < n[2]; ++i2) {
+        for (size_t i1 = 0; i1 < n[1]; ++i1) {
+            const size_t row = i1 * s[1] + i2 * s[2];
+            for (size_t i0 = 0; i0 < n[0]; ++i0) {
+                const size_t id = row + i0;
+                const double c  = in[id];
+                // outside of the block the neighbor is the center
+                const double xm = (i0 > 0) ? in[id - s[0]] : c;
+                const double xp = (i0 < n[0] - 1) ? in[id + s[0]] : c;
+                const double ym = (i1 > 0) ? in[id - s[1]] : c;
+                const double yp = (i1 < n[1] - 1) ? in[id + s[1]] : c;
+                const double zm = (i2 > 0) ? in[id - s[2]] : c;
+                const double zp = (i2 < n[2] - 1) ? in[id + s[2]] : c;
+                out[id]         = xm + xp + ym + yp + zm + zp - 6.0 * c;
+            }
+        }
+    }
+    for (size_t id = n[0] * n[1] * n[2]; id < count; ++id) {
+        out[id] = in[id];
+    }
+}
+
+void kernel_produce(const int kernel, const size_t count, double* data, const double* a, const double* b) {
+    switch (kernel) {
+        case (part_kernel_none): {
+        } break;
+        case (part_kernel_fill): {
+            for (size_t i = 0; i < count; ++i) {
+                data[i] = (double)i;
+            }
+        } break;
+        case (part_kernel_triad): {
+            const double scalar = 3.0;
+            for (size_t i = 0; i < count; ++i) {
+                data[i] = a[i] + scalar * b[i];
+            }
+        } break;
+        case (part_kernel_stencil): {
+            stencil(count, data, a);
+        } break;
+        default:
+            m_assert(false, "unknown kernel %d", kernel);
+    }
+}
+
+void kernel_consume(const int consume, const size_t count, const double* data, double* out) {
+    switch (consume) {
+        case (part_consume_none): {
+        } break;
+        case (part_consume_read): {
+            double sum = 0.0;
+            for (size_t i = 0; i < count; ++i) {
+                sum += data[i];
+            }
+            out[0] = sum;
+        } break;
+        case (part_consume_triad): {
+            const double scalar = 3.0;
+            for (size_t i = 0; i < count; ++i) {
+                out[i] += scalar * data[i];
+            }
+        } break;
+        case (part_consume_stencil): {
+            stencil(count, out, data);
+        } break;
+        default:
+            m_assert(false, "unknown consume kernel %d", consume);
+    }
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef KERNEL_HPP_
+#define KERNEL_HPP_
+
+#include <cstddef>
+
+// the computation done on a partition
+enum part_kernel_t {
+    part_kernel_none    = 0,  // nothing
+    part_kernel_fill    = 1,  // write a value in every entry
+    part_kernel_triad   = 2,  // STREAM triad: data = a + s * b
+    part_kernel_stencil = 3,  // 7-point stencil sweep: data = laplacian(a)
+};
+
+/* Produce the data of one partition before it is marked as ready
+ *
+ * data is the partition and a, b are the same partition in the two auxiliary arrays.
+ * The stencil considers the partition as a 3D block of size n x n x (count/n^2) with n = cbrt(count),
+ * the neighbors outside of the block are replaced by the center value.
+ */
+void kernel_produce(const int kernel, const size_t count, double* data, const double* a, const double* b);
+
+// the computation done on a partition once it has arrived
+enum part_consume_t {
+    part_consume_none    = 0,  // nothing
+    part_consume_read    = 1,  // sum of the entries, stored in out[0]
+    part_consume_triad   = 2,  // STREAM triad update: out = out + s * data
+    part_consume_stencil = 3,  // 7-point stencil sweep: out = laplacian(data)
+};
+
+/* Consume the data of one partition on the receiver
+ *
+ * data is the received partition and out the same partition in the output array.
+ */
+void kernel_consume(const int consume, const size_t count, const double* data, double* out);
+
+#endif
@@ -4,6 +4,7 @@
  */
 #include <cxxabi.h>
 #include <mpi.h>
+#include <omp.h>
 
 #include <cstdio>
 
@@ -13,14 +14,26 @@
 #include "bw_part.hpp"
 #include "bw_part_single.hpp"
 #include "bw_part_multi.hpp"
+#include "bw_part_aggr.hpp"
+#include "bw_part_dtype.hpp"
+#include "bw_part_ratio.hpp"
 #include "bw_part_stream.hpp"
 #include "bw_part_rma.hpp"
 #include "bw_part_rma_active.hpp"
 #include "bw_part_rma_single_active.hpp"
 #include "bw_part_rma_single.hpp"
 #include "bw_part_rma_fence.hpp"
+#include "bw_part_rma_notify.hpp"
+#include "bw_part_shm.hpp"
+#include "output.hpp"
+#include "part_registry.hpp"
+#include "sweep.hpp"
+#include "timer.hpp"
 #include "tools.hpp"
 
+#include <string>
+#include <vector>
+
 template <class T>
 void print_name(T obj) {
     int status;
@@ -28,6 +41,42 @@ void print_name(T obj) {
            abi::__cxa_demangle(typeid(obj).name(), 0, 0, &status));
 }
 
+// the factory of a point-to-point test
+template <class O, class Arg>
+TestPt2PtBw* pt2pt_new(const std::vector<int>& arg) {
+    return new O(test::from_vector<Arg>(arg));
+}
+
+// the point-to-point tests comparing the hand-packing and the MPI datatypes, their keys follow the ones of bw_arg_t
+struct pt2pt_entry_t {
+    const char*              name;
+    std::vector<const char*> keys;
+    TestPt2PtBw* (*factory)(const std::vector<int>& arg);
+};
+static const std::vector<pt2pt_entry_t> pt2pt_tests = {
+    {"pack", {"bcount", "bsize", "bstride", "pack"}, pt2pt_new<BwPack, bw_pack_arg_t>},
+    {"pack3d", {"block3d", "size3d", "pack"}, pt2pt_new<BwPack3D, bw_pack3d_arg_t>},
+    {"dtype3d", {"block3d", "size3d"}, pt2pt_new<BwDtype3D, bw_dtype3d_arg_t>},
+};
+
+// the runtime options of TestPartBw and their key in the parameter space
+static const std::vector<std::pair<const char*, int TestPartOpt::*>> part_opt_keys = {
+    {"n_threads", &TestPartOpt::n_threads},
+    {"mode", &TestPartOpt::mode},
+    {"timeline", &TestPartOpt::timeline},
+    {"noise_model", &TestPartOpt::noise_model},
+    {"kernel", &TestPartOpt::kernel},
+    {"consume", &TestPartOpt::consume},
+    {"page", &TestPartOpt::page},
+    {"align", &TestPartOpt::align},
+    {"arena", &TestPartOpt::arena},
+    {"win_cache", &TestPartOpt::win_cache},
+    {"win_flavor", &TestPartOpt::win_flavor},
+    {"stat", &TestPartOpt::stat},
+    {"sampling", &TestPartOpt::sampling},
+    {"budget", &TestPartOpt::budget},
+};
+
 int main(int argc, char * argv[]){
     // init MPI and the Google bench
     //MPI_Init(&argc,&argv);
@@ -42,25 +91,170 @@ int main(int argc, char * argv[]){
 
     //--------------------------------------------------------------------------
     {
-        m_combine(
-            /* n_partpt */ m_values(1,2,4,8,16,32),
-            /* n_warmup */ m_values(1),
-            /* n_repeat */ m_values(150),
-            /* max_count */ m_values(1<<22),
-            /* noise_level */ m_values(0,10,100)
-            ) opt;
-        m_test(BwPartSingle, opt);
-        //m_test(BwPartStream, opt);
-        m_test(BwPartMulti, opt);
-        m_test(BwPartRma, opt);
-        m_test(BwPartRmaActive, opt);
-        m_test(BwPartRmaSingle, opt);
-        m_test(BwPartRmaSingleActive, opt);
-        m_test(BwPartRmaFence, opt);
-        // must be last :-)
-        m_test(BwPart, opt);
+        // the built-in strategies, the name is the prefix of the result files
+        PartRegistry::Register("part", part_new<BwPart>);
+        PartRegistry::Register("single", part_new<BwPartSingle>);
+        PartRegistry::Register("multi", part_new<BwPartMulti>);
+        PartRegistry::Register("aggr", part_new<BwPartAggr, part_aggr_arg_t>, {{"aggr", "1,2,4,8"}});
+        PartRegistry::Register("part_ratio", part_new<BwPartRatio, part_ratio_arg_t>, {{"ratio", "1,4,-4"}});
+        PartRegistry::Register("part_dtype", part_new_dtype<part_strided_dtype>,
+                               {{"dtype_block", "1,8,64"}, {"dtype_stride", "2"}});
+        PartRegistry::Register("part_pack", part_new_dtype<part_strided_pack>,
+                               {{"dtype_block", "1,8,64"}, {"dtype_stride", "2"}});
+        PartRegistry::Register("stream", part_new<BwPartStream>);
+        PartRegistry::Register("rma", part_new<BwPartRma>);
+        PartRegistry::Register("rma_active", part_new<BwPartRmaActive>);
+        PartRegistry::Register("rma_single", part_new<BwPartRmaSingle>);
+        PartRegistry::Register("rma_single_active", part_new<BwPartRmaSingleActive>);
+        PartRegistry::Register("rma_fence", part_new<BwPartRmaFence>);
+        PartRegistry::Register("rma_notify_flag", part_new_notify<part_notify_flag>);
+        PartRegistry::Register("rma_notify_acc", part_new_notify<part_notify_acc>);
+        PartRegistry::Register("rma_notify_fop", part_new_notify<part_notify_fop>);
+        PartRegistry::Register("shm", part_new<BwPartShm>);
+
+        // the parameter space, the default values can be overwritten at runtime (see sweep.hpp)
+        Sweep sweep;
+        sweep.Parse(argc, argv);
+        sweep.Default("plugin", "");
+        for (const std::string& plugin : sweep.Names("plugin")) {
+            PartRegistry::LoadPlugin(plugin.c_str());
+        }
+        sweep.Default("n_partpt", "1,2,4,8,16,32");
+        sweep.Default("n_warmup", "1");
+        sweep.Default("n_repeat", "150");
+        sweep.Default("max_count", "1<<22");
+        sweep.Default("noise_level", "0,10,100");
+        // the threads of the job by default, fewer threads keep the first places under OMP_PROC_BIND=close
+        const int max_threads = omp_get_max_threads();
+        sweep.Default("n_threads", std::to_string(max_threads).c_str());
+        sweep.Default("mode", "bw");
+        sweep.Enum("mode", {"bw", "pingpong"});
+        sweep.Default("timeline", "0");
+        sweep.Default("noise_model", "last");
+        sweep.Enum("noise_model", {"last", "gauss", "exp", "straggler", "trace"});
+        sweep.Default("noise_trace", "");
+        sweep.Default("kernel", "none");
+        sweep.Enum("kernel", {"none", "fill", "triad", "stencil"});
+        sweep.Default("consume", "none");
+        sweep.Enum("consume", {"none", "read", "triad", "stencil"});
+        sweep.Default("page", "default");
+        sweep.Enum("page", {"default", "thp", "2m", "1g"});
+        sweep.Default("align", "64");
+        sweep.Default("arena", "none");
+        sweep.Enum("arena", {"none", "malloc", "mpi"});
+        sweep.Default("win_cache", "0");
+        sweep.Default("win_flavor", "create");
+        sweep.Enum("win_flavor", {"create", "allocate", "dynamic"});
+        sweep.Default("stat", "mean");
+        sweep.Enum("stat", {"mean", "median", "p90", "p99", "p999", "trim"});
+        sweep.Default("sampling", "rerun");
+        sweep.Enum("sampling", {"rerun", "adaptive"});
+        sweep.Default("budget", "60");
+        sweep.Default("timer", "wtime");
+        sweep.Enum("timer", {"wtime", "tsc", "mono"});
+        sweep.Default("format", "txt");
+        sweep.Enum("format", {"txt", "csv", "jsonl"});
+        sweep.Default("raw", "0");
+        // BwPart must be last :-)
+        sweep.Default("strategy", "single,multi,rma,rma_active,rma_single,rma_single_active,rma_fence,part");
+        for (const PartRegistry::Entry& entry : PartRegistry::List()) {
+            for (const part_key_t& key : entry.keys) {
+                sweep.Default(key.first.c_str(), key.second.c_str());
+            }
+        }
+        // the point-to-point tests, none by default
+        sweep.Default("pt2pt", "");
+        sweep.Default("pt2pt_count", "16");
+        sweep.Default("n_msg", "1");
+        sweep.Default("bcount", "1024");
+        sweep.Default("bsize", "1,4,64");
+        sweep.Default("bstride", "128");
+        sweep.Default("block3d", "4,16,64");
+        sweep.Default("size3d", "64");
+        sweep.Default("pack", "memcpy");
+        sweep.Enum("pack", {"memcpy", "simd", "nt", "omp"});
+        sweep.Check();
+        sweep.Log();
+        for (const int n_threads : sweep.Ints("n_threads")) {
+            m_assert(n_threads > 0, "the number of threads must be positive: %d", n_threads);
+            if (!rank && n_threads > max_threads) {
+                m_log("warning: %d threads oversubscribe the %d of the job", n_threads, max_threads);
+            }
+        }
+
+        // the timer is the same for the whole benchmark, calibrated before the first test
+        PartTimer::Init(sweep.Ints("timer")[0]);
+        if (!rank) {
+            PartTimer::Log();
+        }
+        PartOutput::Init(sweep.Ints("format")[0]);
+        PartRaw::Init(sweep.Ints("raw")[0]);
+
+        // the strategy is the slowest varying dimension, then the parameters in the order of part_arg_t,
+        // the runtime options and the extra keys of the strategy
+        for (const std::string& name : sweep.Names("strategy")) {
+            const PartRegistry::Entry* entry = PartRegistry::Find(name);
+            m_assert(entry != nullptr, "unknown strategy <%s>", name.c_str());
+
+            std::vector<std::string> keys = {"n_partpt", "n_warmup", "n_repeat", "max_count", "noise_level"};
+            for (const auto& key : part_opt_keys) {
+                keys.push_back(key.first);
+            }
+            for (const part_key_t& key : entry->keys) {
+                keys.push_back(key.first);
+            }
+            for (const std::vector<int>& point : sweep.Combine(keys)) {
+                // split the point into the options and the arguments of the strategy
+                TestPartOpt      opt;
+                opt.noise_trace = sweep.Names("noise_trace").empty() ? "" : sweep.Names("noise_trace")[0];
+                opt.meta.push_back({"strategy", name});
+                for (size_t i = 0; i < keys.size(); ++i) {
+                    opt.meta.push_back({keys[i], sweep.Name(keys[i].c_str(), point[i])});
+                }
+                if (opt.noise_model == part_noise_trace) {
+                    opt.meta.push_back({"noise_trace", opt.noise_trace});
+                }
+                std::vector<int> arg(point.begin(), point.begin() + part_arg_s);
+                for (size_t i = 0; i < part_opt_keys.size(); ++i) {
+                    opt.*(part_opt_keys[i].second) = point[part_arg_s + i];
+                }
+                arg.insert(arg.end(), point.begin() + part_arg_s + part_opt_keys.size(), point.end());
+
+                TestPartBw::SetOpt(opt);
+                TestPartBw* test = entry->factory(arg);
+                TestPartBw* pong = nullptr;
+                if (opt.mode == part_mode_pingpong) {
+                    pong = entry->factory(arg);
+                    test->SetPong(pong);
+                }
+                test->run();
+                delete pong;
+                delete test;
+            }
+        }
+
+        // the point-to-point tests run on the threads of the job
+        omp_set_num_threads(max_threads);
+        for (const std::string& name : sweep.Names("pt2pt")) {
+            const pt2pt_entry_t* entry = nullptr;
+            for (const pt2pt_entry_t& it : pt2pt_tests) {
+                entry = (name == it.name) ? &it : entry;
+            }
+            m_assert(entry != nullptr, "unknown point-to-point test <%s>", name.c_str());
+
+            std::vector<std::string> keys = {"pt2pt_count", "n_msg", "n_repeat"};
+            keys.insert(keys.end(), entry->keys.begin(), entry->keys.end());
+            for (const std::vector<int>& point : sweep.Combine(keys)) {
+                TestPt2PtBw* test = entry->factory(point);
+                test->run();
+                delete test;
+            }
+        }
     }
     //--------------------------------------------------------------------------
+    PartRaw::Close();
+    PartWinCache::Free();
+    PartArena::Free();
     MPI_Finalize();
 };
 
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "noise.hpp"
+
+#include <mpi.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "timer.hpp"
+#include "tools.hpp"
+
+double noise_spin(const double time) {
+    const double   freq  = PartTimer::CycleFreq();
+    const uint64_t start = timer_cycles();
+    const uint64_t end   = start + (uint64_t)(time * freq);
+    uint64_t       now;
+    do {
+        now = timer_cycles();
+    } while (now < end);
+    return (now - start) / freq;
+}
+
+//==============================================================================
+PartNoise::PartNoise(const int model, const int n_part, const int n_threads, const char* trace_file)
+    : model_{model}, n_part_{n_part}, n_threads_{n_threads}, gen_{std::random_device{}()}, trace_pos_{0} {
+    if (model_ == part_noise_trace) {
+        // one delay in usec per line, # starts a comment
+        FILE* file = fopen(trace_file, "r");
+        m_assert(file != nullptr, "unable to open the noise trace <%s>", trace_file);
+        char line[256];
+        while (fgets(line, 256, file)) {
+            char*        end;
+            const double val = strtod(line, &end);
+            if (end != line) {
+                trace_.push_back(val * 1.0e-6);
+            }
+        }
+        fclose(file);
+        m_assert(!trace_.empty(), "the noise trace <%s> is empty", trace_file);
+    }
+}
+
+void PartNoise::Draw(const double scale, double* delay) {
+    for (int ip = 0; ip < n_part_; ++ip) {
+        delay[ip] = 0.0;
+    }
+    if (scale <= 0.0) {
+        return;
+    }
+    switch (model_) {
+        case (part_noise_last): {
+            delay[n_part_ - 1] = scale;
+        } break;
+        case (part_noise_gauss): {
+            // no negative delay here
+            std::normal_distribution<double> noise{0.0, scale};
+            for (int ip = 0; ip < n_part_; ++ip) {
+                delay[ip] = fabs(noise(gen_));
+            }
+        } break;
+        case (part_noise_exp): {
+            std::exponential_distribution<double> noise{1.0 / scale};
+            for (int ip = 0; ip < n_part_; ++ip) {
+                delay[ip] = noise(gen_);
+            }
+        } break;
+        case (part_noise_straggler): {
+            // every partition of the thread is delayed, the thread owns a contiguous block with schedule(static)
+            std::uniform_int_distribution<int> noise{0, n_threads_ - 1};
+            const int                          ith = noise(gen_);
+            for (int ip = ith * n_part_ / n_threads_; ip < (ith + 1) * n_part_ / n_threads_; ++ip) {
+                delay[ip] = scale;
+            }
+        } break;
+        case (part_noise_trace): {
+            for (int ip = 0; ip < n_part_; ++ip) {
+                delay[ip] = scale * trace_[trace_pos_];
+                trace_pos_ = (trace_pos_ + 1) % trace_.size();
+            }
+        } break;
+        default:
+            m_assert(false, "unknown noise model %d", model_);
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef NOISE_HPP_
+#define NOISE_HPP_
+
+#include <random>
+#include <string>
+#include <vector>
+
+// the distribution of the delays applied before Pready
+enum part_noise_t {
+    part_noise_last      = 0,  // only the last partition is delayed
+    part_noise_gauss     = 1,  // every partition is delayed by |N(0,noise)|
+    part_noise_exp       = 2,  // every partition is delayed by Exp(1/noise)
+    part_noise_straggler = 3,  // one random thread per iteration, each of its partitions is delayed by noise
+    part_noise_trace     = 4,  // the delays are replayed from a recorded trace
+};
+
+/* Noise injected on the sender before each partition becomes ready
+ *
+ * The delays are drawn for every iteration outside of the timed region and applied with noise_spin().
+ * The scale of the noise is given per partition, in seconds. For the trace, the recorded delays are
+ * multiplied by the scale, a scale of 1 replays the trace as recorded.
+ */
+class PartNoise {
+    const int  model_;     // see part_noise_t
+    const int  n_part_;    // the number of partitions
+    const int  n_threads_; // the number of threads, the partitions are distributed with schedule(static)
+    std::mt19937 gen_;
+
+    std::vector<double> trace_;      // the recorded delays in seconds
+    size_t              trace_pos_;  // the next delay to replay
+
+   public:
+    PartNoise(const int model, const int n_part, const int n_threads, const char* trace_file);
+
+    // fill the delay of every partition for one iteration given the scale of the noise
+    void Draw(const double scale, double* delay);
+};
+
+// busy-wait for the given time (in sec) on the cycle counter calibrated by PartTimer::Init(), returns the time actually spent
+double noise_spin(const double time);
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "output.hpp"
+
+#include <mpi.h>
+#include <omp.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "timer.hpp"
+#include "tools.hpp"
+
+#define OUTPUT_BUF_SIZE (1 << 16)  // the rows are written once the buffer exceeds this size in bytes
+
+extern char** environ;
+
+int         PartOutput::format_ = part_format_txt;
+part_meta_t PartOutput::run_meta_;
+
+// the value as a JSON number if it is one, as a JSON string otherwise
+static std::string json_value(const std::string& value) {
+    char* end;
+    strtod(value.c_str(), &end);
+    if (!value.empty() && *end == '\0' && value.find_first_of("xXnN") == std::string::npos) {
+        return value;
+    }
+    std::string str = "\"";
+    for (const char c : value) {
+        if (c == '"' || c == '\\') {
+            str += '\\';
+            str += c;
+        } else if ((unsigned char)c < 0x20) {
+            str += ' ';
+        } else {
+            str += c;
+        }
+    }
+    return str + "\"";
+}
+
+// the first line of a string, without the trailing spaces
+static std::string first_line(const char* str) {
+    std::string line(str, strcspn(str, "\n\r"));
+    return line.substr(0, line.find_last_not_of(" \t") + 1);
+}
+
+void PartOutput::Init(const int format) {
+    format_ = format;
+    run_meta_.clear();
+
+    int rank, comm_size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
+
+    // the MPI library
+    int version, subversion;
+    MPI_Get_version(&version, &subversion);
+    char library[MPI_MAX_LIBRARY_VERSION_STRING];
+    int  len;
+    MPI_Get_library_version(library, &len);
+    run_meta_.push_back({"mpi_version", std::to_string(version) + "." + std::to_string(subversion)});
+    run_meta_.push_back({"mpi_library", first_line(library)});
+
+    // the host topology: a node is a shared-memory communicator, counted by its rank 0
+    MPI_Comm node_comm;
+    int      node_rank, node_size;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_size(node_comm, &node_size);
+    MPI_Comm_free(&node_comm);
+    int leader = (node_rank == 0);
+    int n_node, max_ppn;
+    MPI_Reduce(&leader, &n_node, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&node_size, &max_ppn, 1, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
+    if (rank != 0) {
+        return;
+    }
+    char host[256] = {0};
+    gethostname(host, 255);
+    run_meta_.push_back({"n_ranks", std::to_string(comm_size)});
+    run_meta_.push_back({"n_nodes", std::to_string(n_node)});
+    run_meta_.push_back({"ranks_per_node", std::to_string(max_ppn)});
+    run_meta_.push_back({"host", host});
+    run_meta_.push_back({"n_cores", std::to_string(sysconf(_SC_NPROCESSORS_ONLN))});
+    run_meta_.push_back({"omp_max_threads", std::to_string(omp_get_max_threads())});
+
+    // the timer
+    char value[64];
+    run_meta_.push_back({"timer", PartTimer::Name()});
+    snprintf(value, 64, "%e", PartTimer::Resolution());
+    run_meta_.push_back({"timer_resolution", value});
+    snprintf(value, 64, "%e", PartTimer::Overhead());
+    run_meta_.push_back({"timer_overhead", value});
+
+    // the date of the run and the environment driving the MPI library and the threads
+    const time_t now = time(nullptr);
+    strftime(value, 64, "%Y-%m-%dT%H:%M:%S", localtime(&now));
+    run_meta_.push_back({"date", value});
+    for (char** env = environ; *env; ++env) {
+        if (strncmp(*env, "MPIR_CVAR_", 10) && strncmp(*env, "OMP_", 4)) {
+            continue;
+        }
+        const char* eq = strchr(*env, '=');
+        if (eq) {
+            run_meta_.push_back({std::string(*env, eq - *env), eq + 1});
+        }
+    }
+}
+
+//==============================================================================
+PartOutput::PartOutput(const char* filename, const part_meta_t& meta, const std::vector<part_col_t>& cols)
+    : cols_{cols} {
+    // the extension follows the format
+    std::string name(filename);
+    const char* ext[3] = {".txt", ".csv", ".jsonl"};
+    if (name.size() > 4 && name.compare(name.size() - 4, 4, ".txt") == 0) {
+        name = name.substr(0, name.size() - 4) + ext[format_];
+    }
+    // create the directory if needed
+    const size_t slash = name.find_last_of('/');
+    if (slash != std::string::npos) {
+        struct stat st = {0};
+        if (stat(name.substr(0, slash).c_str(), &st) == -1) {
+            mkdir(name.substr(0, slash).c_str(), 0770);
+        }
+    }
+    file_ = fopen(name.c_str(), "w+");
+    m_assert(file_ != nullptr, "unable to open the results file <%s>", name.c_str());
+
+    part_meta_t all = run_meta_;
+    all.insert(all.end(), meta.begin(), meta.end());
+    if (format_ == part_format_csv) {
+        for (const auto& it : all) {
+            buf_ += "# " + it.first + " = " + it.second + "\n";
+        }
+        for (size_t ic = 0; ic < cols_.size(); ++ic) {
+            buf_ += std::string(ic ? "," : "") + cols_[ic].name;
+        }
+        buf_ += "\n";
+    } else if (format_ == part_format_jsonl) {
+        buf_ += "{\"meta\": {";
+        for (size_t im = 0; im < all.size(); ++im) {
+            buf_ += std::string(im ? ", " : "") + "\"" + all[im].first + "\": " + json_value(all[im].second);
+        }
+        buf_ += "}}\n";
+    }
+}
+
+PartOutput::~PartOutput() {
+    Flush();
+    fclose(file_);
+}
+
+void PartOutput::Row(const std::vector<double>& values) {
+    m_assert(values.size() == cols_.size(), "%ld values given for %ld columns", values.size(), cols_.size());
+    char val[64];
+    if (format_ == part_format_jsonl) {
+        buf_ += "{";
+    }
+    for (size_t ic = 0; ic < cols_.size(); ++ic) {
+        if (cols_[ic].integer) {
+            snprintf(val, 64, "%ld", (long)values[ic]);
+        } else if (format_ == part_format_jsonl && !std::isfinite(values[ic])) {
+            snprintf(val, 64, "null");
+        } else {
+            snprintf(val, 64, "%e", values[ic]);
+        }
+        if (format_ == part_format_jsonl) {
+            buf_ += std::string(ic ? ", " : "") + "\"" + cols_[ic].name + "\": " + val;
+        } else {
+            buf_ += std::string(ic ? "," : "") + val;
+        }
+    }
+    buf_ += (format_ == part_format_jsonl) ? "}\n" : "\n";
+    if (buf_.size() > OUTPUT_BUF_SIZE) {
+        Flush();
+    }
+}
+
+void PartOutput::Flush() {
+    fwrite(buf_.data(), 1, buf_.size(), file_);
+    fflush(file_);
+    buf_.clear();
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef OUTPUT_HPP_
+#define OUTPUT_HPP_
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+// the format of the results files
+enum part_format_t {
+    part_format_txt   = 0,  // one unlabeled comma-separated row per line
+    part_format_csv   = 1,  // the metadata as `# key = value` lines, a header line and the rows
+    part_format_jsonl = 2,  // a first line {"meta": {...}} and one JSON object per row
+};
+
+// the metadata of a results file, as (key, value) pairs
+using part_meta_t = std::vector<std::pair<std::string, std::string>>;
+
+// a column of a results file, the integer ones are written with %ld and the others with %e
+typedef struct {
+    const char* name;
+    bool        integer;
+} part_col_t;
+
+/* Buffered writer of one results file
+ *
+ * The file is written on the rank creating the writer (rank 0) and contains the metadata of the run collected by
+ * Init(), followed by the metadata given to the writer (strategy, parameters) and the rows.
+ * With the txt format, the file holds the rows only and its content is the one of the former results files.
+ * A trailing .txt of the filename is replaced by .csv or .jsonl and its directory is created if needed.
+ * The rows are kept in memory and written once the buffer is full or when the writer is deleted.
+ */
+class PartOutput {
+   public:
+    PartOutput(const char* filename, const part_meta_t& meta, const std::vector<part_col_t>& cols);
+    ~PartOutput();
+
+    // add one row, the values are given in the order of the columns
+    void Row(const std::vector<double>& values);
+    void Flush();
+
+    // select the format and collect the metadata of the run (MPI library, host topology, environment, timer)
+    // collective over MPI_COMM_WORLD, must be called once the timer has been initialized
+    static void Init(const int format);
+
+   private:
+    FILE*                   file_;
+    std::vector<part_col_t> cols_;
+    std::string             buf_;
+
+    static int         format_;
+    static part_meta_t run_meta_;
+};
+
+#endif
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "pack.hpp"
+
+#include <omp.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "tools.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define PACK_SIMD_LEN 4    // the runs shorter than this number of doubles are copied across the runs
+#define PACK_NT_LEN   512  // the runs of at least this number of doubles are written with non-temporal stores
+
+// copy len doubles, the loop is vectorized by the compiler
+static inline void copy_simd(double* __restrict dst, const double* __restrict src, const size_t len) {
+#pragma omp simd
+    for (size_t i = 0; i < len; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+// copy len doubles with non-temporal stores once dst is aligned, the caller issues the fence
+static inline void copy_nt(double* __restrict dst, const double* __restrict src, const size_t len) {
+#if defined(__AVX__) || defined(__SSE2__)
+#if defined(__AVX__)
+    const size_t vec = 4;
+#else
+    const size_t vec = 2;
+#endif
+    size_t i = 0;
+    for (; i < len && ((uintptr_t)(dst + i) % (vec * sizeof(double))); ++i) {
+        dst[i] = src[i];
+    }
+    for (; i + vec <= len; i += vec) {
+#if defined(__AVX__)
+        _mm256_stream_pd(dst + i, _mm256_loadu_pd(src + i));
+#else
+        _mm_stream_pd(dst + i, _mm_loadu_pd(src + i));
+#endif
+    }
+    for (; i < len; ++i) {
+        dst[i] = src[i];
+    }
+#else
+    copy_simd(dst, src, len);
+#endif
+}
+
+static inline void fence_nt() {
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
+}
+
+// copy the runs [i_begin, i_end) of a row, the runs are spaced by src_step in src and by dst_step in dst
+static void copy_row(const int kernel, const size_t len, const size_t i_begin, const size_t i_end,
+                     double* __restrict dst, const size_t dst_step, const double* __restrict src, const size_t src_step) {
+    size_t i = i_begin;
+    if (kernel == part_pack_memcpy) {
+        for (; i < i_end; ++i) {
+            std::memcpy(dst + i * dst_step, src + i * src_step, len * sizeof(double));
+        }
+        return;
+    }
+    if (len < PACK_SIMD_LEN) {
+#if defined(__AVX2__)
+        // single doubles are gathered 4 at a time, AVX2 has no scatter for the unpacking
+        if (len == 1 && dst_step == 1) {
+            const __m256i idx = _mm256_set_epi64x(3 * src_step, 2 * src_step, src_step, 0);
+            for (; i + 4 <= i_end; i += 4) {
+                _mm256_storeu_pd(dst + i, _mm256_i64gather_pd(src + i * src_step, idx, sizeof(double)));
+            }
+        }
+#endif
+#pragma omp simd
+        for (size_t ir = i; ir < i_end; ++ir) {
+            for (size_t id = 0; id < len; ++id) {
+                dst[ir * dst_step + id] = src[ir * src_step + id];
+            }
+        }
+        return;
+    }
+    const bool nt = (kernel != part_pack_simd) && (len >= PACK_NT_LEN);
+    for (; i < i_end; ++i) {
+        if (nt) {
+            copy_nt(dst + i * dst_step, src + i * src_step, len);
+        } else {
+            copy_simd(dst + i * dst_step, src + i * src_step, len);
+        }
+    }
+}
+
+// copy every run of the layout, from the strided array to the dense one if pack is true
+static void copy_layout(const int kernel, const pack_layout_t* l, const bool pack, const double* src, double* dst) {
+    const size_t n_row = l->n[1] * l->n[2];
+    // the runs [i_begin, i_end) of row ir = i1 + n[1] * i2
+    auto row = [=](const size_t ir, const size_t i_begin, const size_t i_end) {
+        const size_t strided = (ir % l->n[1]) * l->stride[1] + (ir / l->n[1]) * l->stride[2];
+        const size_t dense   = ir * l->n[0] * l->len;
+        if (pack) {
+            copy_row(kernel, l->len, i_begin, i_end, dst + dense, l->len, src + strided, l->stride[0]);
+        } else {
+            copy_row(kernel, l->len, i_begin, i_end, dst + strided, l->stride[0], src + dense, l->len);
+        }
+    };
+    if (kernel != part_pack_omp) {
+        for (size_t ir = 0; ir < n_row; ++ir) {
+            row(ir, 0, l->n[0]);
+        }
+        if (kernel == part_pack_nt) {
+            fence_nt();
+        }
+        return;
+    }
+    // a thread gets a contiguous chunk of rows, or of every row if there are fewer rows than threads
+#pragma omp parallel
+    {
+        const int n_threads = omp_get_num_threads();
+        const int ith       = omp_get_thread_num();
+        if (n_row >= (size_t)n_threads) {
+#pragma omp for schedule(static) nowait
+            for (size_t ir = 0; ir < n_row; ++ir) {
+                row(ir, 0, l->n[0]);
+            }
+        } else {
+            for (size_t ir = 0; ir < n_row; ++ir) {
+                row(ir, (ith * l->n[0]) / n_threads, ((ith + 1) * l->n[0]) / n_threads);
+            }
+        }
+        fence_nt();
+    }
+}
+
+void pack_kernel(const int kernel, const pack_layout_t* layout, const double* src, double* dst) {
+    m_assert(kernel >= part_pack_memcpy && kernel <= part_pack_omp, "unknown pack kernel %d", kernel);
+    copy_layout(kernel, layout, true, src, dst);
+}
+
+void unpack_kernel(const int kernel, const pack_layout_t* layout, const double* src, double* dst) {
+    m_assert(kernel >= part_pack_memcpy && kernel <= part_pack_omp, "unknown pack kernel %d", kernel);
+    copy_layout(kernel, layout, false, src, dst);
+}
+
+const char* pack_name(const int kernel) {
+    const char* name[4] = {"memcpy", "simd", "nt", "omp"};
+    return name[kernel];
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef PACK_HPP_
+#define PACK_HPP_
+
+#include <cstddef>
+
+// the kernel copying the runs of a strided array from or into a dense buffer
+enum part_pack_t {
+    part_pack_memcpy = 0,  // one memcpy per run, on the calling thread
+    part_pack_simd   = 1,  // vectorized copies, the short runs are gathered across runs (AVX2 for runs of 1 double)
+    part_pack_nt     = 2,  // simd with non-temporal stores for the long runs, the destination bypasses the cache
+    part_pack_omp    = 3,  // nt with the runs distributed over the threads
+};
+
+/* A 3D set of runs of len contiguous doubles
+ *
+ * The run (i0, i1, i2) starts at i0 * stride[0] + i1 * stride[1] + i2 * stride[2] in the strided array and at
+ * len * (i0 + n[0] * (i1 + n[1] * i2)) in the dense buffer.
+ */
+typedef struct {
+    size_t len;        // the number of doubles in a run
+    size_t n[3];       // the number of runs in each direction
+    size_t stride[3];  // the distance between two runs in each direction, in doubles
+} pack_layout_t;
+
+// copy the runs of the strided array src into the dense buffer dst
+void pack_kernel(const int kernel, const pack_layout_t* layout, const double* src, double* dst);
+
+// copy the dense buffer src into the runs of the strided array dst
+void unpack_kernel(const int kernel, const pack_layout_t* layout, const double* src, double* dst);
+
+// the name of the kernel, used in the results files
+const char* pack_name(const int kernel);
+
+#endif
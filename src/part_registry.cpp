@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "part_registry.hpp"
+
+#include <dlfcn.h>
+
+std::vector<PartRegistry::Entry>& PartRegistry::list_() {
+    // constructed on the first use to be valid from any static initialization
+    static std::vector<Entry> list;
+    return list;
+}
+
+const std::vector<PartRegistry::Entry>& PartRegistry::List() {
+    return list_();
+}
+
+void PartRegistry::Register(const char* name, part_factory_t factory, const std::vector<part_key_t>& keys) {
+    m_assert(Find(name) == nullptr, "the strategy <%s> is already registered", name);
+    list_().push_back({name, factory, keys});
+}
+
+const PartRegistry::Entry* PartRegistry::Find(const std::string& name) {
+    for (const Entry& entry : list_()) {
+        if (entry.name == name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void PartRegistry::LoadPlugin(const char* filename) {
+    // the library is never closed as the vtables of its strategies live in it
+    void* handle = dlopen(filename, RTLD_NOW | RTLD_LOCAL);
+    m_assert(handle != nullptr, "unable to load the plugin <%s>: %s", filename, dlerror());
+
+    using register_t   = void (*)();
+    register_t reg_fun = (register_t)dlsym(handle, m_plugin_symbol);
+    m_assert(reg_fun != nullptr, "the plugin <%s> does not define %s", filename, m_plugin_symbol);
+    reg_fun();
+}
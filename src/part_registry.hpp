@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef PART_REGISTRY_HPP_
+#define PART_REGISTRY_HPP_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test_part_bw.hpp"
+#include "tools.hpp"
+
+// create a strategy from the values of part_arg_t followed by the values of the extra keys
+using part_factory_t = TestPartBw* (*)(const std::vector<int>& arg);
+// an extra key of the parameter space and its default value(s), see sweep.hpp
+using part_key_t = std::pair<std::string, std::string>;
+
+// the factory of a strategy O constructed from an argument Arg (part_arg_t + the extra values)
+template <class O, class Arg = part_arg_t>
+TestPartBw* part_new(const std::vector<int>& arg) {
+    return new O(test::from_vector<Arg>(arg));
+}
+
+/* List of the strategies available at runtime
+ *
+ * The strategies are registered by name, the name being the prefix of their result files.
+ * A strategy can require extra keys in the parameter space, they are appended to part_arg_t in the given order.
+ *
+ * Strategies can also be loaded from a shared library with LoadPlugin(): the library must define the entry point
+ * `m_plugin_register() { ... }` in which it registers its own strategies, e.g.
+ *
+ *      #include "part_registry.hpp"
+ *      class MyPart : public TestPartBw { ... };  // implements the hooks RequestInit, Send_Pready, etc
+ *      m_plugin_register() {
+ *          PartRegistry::Register("my_part", part_new<MyPart>);
+ *      }
+ *
+ * The library is compiled against the headers of src/ and the symbols of TestPartBw are resolved from benchme.
+ */
+class PartRegistry {
+   public:
+    struct Entry {
+        std::string             name;
+        part_factory_t          factory;
+        std::vector<part_key_t> keys;  // the extra keys
+    };
+
+    static void         Register(const char* name, part_factory_t factory, const std::vector<part_key_t>& keys = {});
+    static const Entry* Find(const std::string& name);
+    static const std::vector<Entry>& List();
+
+    // open the shared library and call its registration function
+    static void LoadPlugin(const char* filename);
+
+   private:
+    static std::vector<Entry>& list_();
+};
+
+// name of the entry point of a plugin
+#define m_plugin_symbol "benchme_plugin_register"
+#define m_plugin_register() extern "C" void benchme_plugin_register()
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "raw.hpp"
+
+#include <mpi.h>
+#include <sys/stat.h>
+
+#include <cstdlib>
+
+#include "tools.hpp"
+
+FILE*   PartRaw::data_   = nullptr;
+FILE*   PartRaw::index_  = nullptr;
+int64_t PartRaw::offset_ = 0;
+
+void PartRaw::Init(const bool enabled) {
+    if (!enabled) {
+        return;
+    }
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    struct stat st = {0};
+    if (stat("results", &st) == -1) {
+        mkdir("results", 0770);
+    }
+    char name[512];
+    snprintf(name, 512, "results/raw_r%d.bin", rank);
+    data_ = fopen(name, "wb");
+    m_assert(data_ != nullptr, "unable to open the raw file <%s>", name);
+    snprintf(name, 512, "results/raw_r%d.idx", rank);
+    index_ = fopen(name, "wb");
+    m_assert(index_ != nullptr, "unable to open the raw index <%s>", name);
+    offset_ = 0;
+}
+
+void PartRaw::Append(part_raw_entry_t* entry, const double* t_iter, const double* t_cmpt, const double* t_thread,
+                     const double* c_thread) {
+    const int n_iter    = entry->n_iter;
+    const int n_threads = entry->n_threads;
+    entry->offset       = offset_;
+    fwrite(t_iter, sizeof(double), n_iter, data_);
+    fwrite(t_cmpt, sizeof(double), n_iter, data_);
+    // the threads are stored as columns
+    double* column = (double*)malloc(n_iter * sizeof(double));
+    for (const double* data : {t_thread, c_thread}) {
+        for (int ith = 0; ith < n_threads; ++ith) {
+            for (int iter = 0; iter < n_iter; ++iter) {
+                column[iter] = data[iter * n_threads + ith];
+            }
+            fwrite(column, sizeof(double), n_iter, data_);
+        }
+    }
+    free(column);
+    fwrite(entry, sizeof(part_raw_entry_t), 1, index_);
+    offset_ += (int64_t)(2 + 2 * n_threads) * n_iter;
+}
+
+void PartRaw::Close() {
+    if (data_) {
+        fclose(data_);
+        fclose(index_);
+        data_  = nullptr;
+        index_ = nullptr;
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef RAW_HPP_
+#define RAW_HPP_
+
+#include <cstdint>
+#include <cstdio>
+
+// one block of samples in the index file, a fixed-size record to be read without parsing (see results/raw.py)
+typedef struct {
+    char    test[512];  // the name of the results file of the test (strategy, threads, partitions, noise)
+    int64_t size;       // the number of bytes exchanged
+    int64_t offset;     // the position of the block in the data file, in doubles
+    int32_t n_iter;     // the number of iterations, warmup included
+    int32_t i_first;    // the first measured iteration
+    int32_t n_threads;  // the number of threads
+    int32_t rank;       // the rank in MPI_COMM_WORLD
+    int32_t n_ranks;    // the size of MPI_COMM_WORLD, rank i < n_ranks/2 sends to i + n_ranks/2
+    int32_t sender;     // 1 if the rank sends (the first way of the ping-pong)
+    int32_t pingpong;   // 1 for the ping-pong mode
+    int32_t reserved;
+} part_raw_entry_t;
+
+/* Store of the raw timings of every iteration
+ *
+ * Every rank appends its samples to results/raw_r<rank>.bin, one block of float64 columns per size of every test:
+ * - t_iter[n_iter]: the time of the iteration (the slowest thread)
+ * - t_cmpt[n_iter]: the time in the kernel and the noise, in the consumer on the receiver (the slowest thread)
+ * - t_thread[n_threads][n_iter]: the time of the iteration of every thread
+ * - c_thread[n_threads][n_iter]: the time in the kernel and the noise (in the consumer) of every thread
+ * and one part_raw_entry_t per block to results/raw_r<rank>.idx.
+ * Both files can be mapped in memory, they are recreated by Init().
+ */
+class PartRaw {
+   public:
+    static void Init(const bool enabled);
+    static bool Enabled() { return data_ != nullptr; }
+    // append a block, t_thread and c_thread are given as [n_iter][n_threads]
+    static void Append(part_raw_entry_t* entry, const double* t_iter, const double* t_cmpt, const double* t_thread,
+                       const double* c_thread);
+    // close the files, must be called before MPI_Finalize
+    static void Close();
+
+   private:
+    static FILE*   data_;
+    static FILE*   index_;
+    static int64_t offset_;  // the size of the data file in doubles
+};
+
+#endif
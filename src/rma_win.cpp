@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "rma_win.hpp"
+
+void part_win_create(const int flavor, const bool sender, void* buf, const MPI_Aint size, MPI_Info win_info,
+                     put_info_t* info) {
+    info->disp   = 0;
+    info->local  = sender ? nullptr : buf;
+    info->flavor = flavor;
+    switch (flavor) {
+        case (part_flavor_create): {
+            // size is 0 on the sender, address can then be NULL
+            MPI_Win_create(sender ? NULL : buf, sender ? 0 : size, 1, win_info, info->comm, &(info->win));
+        } break;
+        case (part_flavor_allocate): {
+            MPI_Win_allocate(sender ? 0 : size, 1, win_info, info->comm, &(info->local), &(info->win));
+        } break;
+        case (part_flavor_dynamic): {
+            // the displacements are addresses on the target, the receiver gives its own to the sender
+            const int tag = 3;  // 1 and 2 are used by the strategies
+            MPI_Win_create_dynamic(win_info, info->comm, &(info->win));
+            if (sender) {
+                MPI_Recv(&(info->disp), 1, MPI_AINT, info->target_rank, tag, info->comm, MPI_STATUS_IGNORE);
+            } else {
+                MPI_Aint addr;
+                MPI_Win_attach(info->win, buf, size);
+                MPI_Get_address(buf, &addr);
+                MPI_Send(&addr, 1, MPI_AINT, info->target_rank, tag, info->comm);
+            }
+        } break;
+        default:
+            m_assert(false, "unknown window flavor %d", flavor);
+    }
+}
+
+void part_win_free(const bool sender, put_info_t* info) {
+    if (info->flavor == part_flavor_dynamic && !sender) {
+        MPI_Win_detach(info->win, info->local);
+    }
+    MPI_Win_free(&(info->win));
+}
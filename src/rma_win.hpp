@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef RMA_WIN_HPP_
+#define RMA_WIN_HPP_
+
+#include <mpi.h>
+
+#include "tools.hpp"
+
+// how the windows of the RMA strategies are created
+enum part_flavor_t {
+    part_flavor_create   = 0,  // MPI_Win_create on the buffer
+    part_flavor_allocate = 1,  // MPI_Win_allocate, the memory is owned by the library
+    part_flavor_dynamic  = 2,  // MPI_Win_create_dynamic + MPI_Win_attach of the buffer
+};
+
+/* create info->win on info->comm, exposing size bytes on the receiver and nothing on the sender
+ *
+ * On the receiver, the memory is buf for create and dynamic and a new one for allocate, it is returned in info->local.
+ * On the sender, info->disp is set to the target displacement of the beginning of the buffer:
+ * 0 for create and allocate, the address of buf on the receiver for dynamic.
+ * The window must be freed with part_win_free()
+ */
+void part_win_create(const int flavor, const bool sender, void* buf, const MPI_Aint size, MPI_Info win_info,
+                     put_info_t* info);
+void part_win_free(const bool sender, put_info_t* info);
+
+#endif
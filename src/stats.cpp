@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "stats.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "tools.hpp"
+
+// the q-quantile of the n sorted samples, linearly interpolated between the closest ranks
+static double stat_quantile(const int n, const double* sorted, const double q) {
+    const double pos = q * (n - 1);
+    const int    low = (int)std::floor(pos);
+    const int    up  = m_min(low + 1, n - 1);
+    return sorted[low] + (pos - low) * (sorted[up] - sorted[low]);
+}
+
+// the statistic of the n sorted samples
+static double stat_sorted(const int stat, const int n, const double* sorted) {
+    switch (stat) {
+        case part_stat_mean: {
+            double sum = 0.0;
+            for (int i = 0; i < n; ++i) {
+                sum += sorted[i];
+            }
+            return sum / n;
+        }
+        case part_stat_median:
+            return stat_quantile(n, sorted, 0.5);
+        case part_stat_p90:
+            return stat_quantile(n, sorted, 0.9);
+        case part_stat_p99:
+            return stat_quantile(n, sorted, 0.99);
+        case part_stat_p999:
+            return stat_quantile(n, sorted, 0.999);
+        case part_stat_trim: {
+            // keep at least one sample
+            const int n_trim = m_min((int)(STAT_TRIM * n), (n - 1) / 2);
+            double    sum    = 0.0;
+            for (int i = n_trim; i < n - n_trim; ++i) {
+                sum += sorted[i];
+            }
+            return sum / (n - 2 * n_trim);
+        }
+        default:
+            m_assert(false, "unknown statistic %d", stat);
+            return 0.0;
+    }
+}
+
+void stat_all(const int n, const double* data, double* value) {
+    m_assert(n > 0, "the number of samples = %d must be positive", n);
+    double* sorted = (double*)malloc(n * sizeof(double));
+    memcpy(sorted, data, n * sizeof(double));
+    std::sort(sorted, sorted + n);
+    for (int is = 0; is < STAT_N; ++is) {
+        value[is] = stat_sorted(is, n, sorted);
+    }
+    free(sorted);
+}
+
+double stat_boot_ci(const int stat, const int n, const double* data) {
+    m_assert(n > 0, "the number of samples = %d must be positive", n);
+    std::mt19937                       gen(2023);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+
+    double* sample = (double*)malloc(n * sizeof(double));
+    double* boot   = (double*)malloc(STAT_BOOT * sizeof(double));
+    for (int ib = 0; ib < STAT_BOOT; ++ib) {
+        for (int i = 0; i < n; ++i) {
+            sample[i] = data[pick(gen)];
+        }
+        std::sort(sample, sample + n);
+        boot[ib] = stat_sorted(stat, n, sample);
+    }
+    std::sort(boot, boot + STAT_BOOT);
+    const double ci = 0.5 * (stat_quantile(STAT_BOOT, boot, 0.95) - stat_quantile(STAT_BOOT, boot, 0.05));
+    free(sample);
+    free(boot);
+    return ci;
+}
+
+int stat_warmup(const int n, const double* data) {
+    // accumulate from the end to get the mean and the variance of every tail in one pass
+    double sum    = 0.0;
+    double sum_sq = 0.0;
+    double best   = DBL_MAX;
+    int    i_best = 0;
+    for (int d = n - 1; d >= 0; --d) {
+        sum += data[d];
+        sum_sq += data[d] * data[d];
+        const int n_tail = n - d;
+        if (d > n / 2) {
+            continue;
+        }
+        // sum of the squared deviations over n_tail^2
+        const double mser = (sum_sq - sum * sum / n_tail) / ((double)n_tail * n_tail);
+        if (mser <= best) {
+            best   = mser;
+            i_best = d;
+        }
+    }
+    return i_best;
+}
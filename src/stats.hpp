@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef STATS_HPP_
+#define STATS_HPP_
+
+// the statistic of the per-iteration samples reported as the time and used for the reruns
+enum part_stat_t {
+    part_stat_mean   = 0,  // the mean, its CI comes from the Student t and not from stat_boot_ci(), see below
+    part_stat_median = 1,  // the 50th percentile
+    part_stat_p90    = 2,  // the 90th percentile
+    part_stat_p99    = 3,  // the 99th percentile
+    part_stat_p999   = 4,  // the 99.9th percentile, the maximum unless n_repeat >= 1000
+    part_stat_trim   = 5,  // the mean without the STAT_TRIM lowest and highest samples
+};
+#define STAT_N    6     // the number of statistics in part_stat_t
+#define STAT_TRIM 0.1   // the fraction of the samples trimmed on each side
+#define STAT_BOOT 1000  // the number of bootstrap resamples
+
+// fill value[STAT_N] with every statistic of the n samples in data
+void stat_all(const int n, const double* data, double* value);
+
+/* the half-width of the 90% confidence interval of the statistic stat of the n samples in data.
+ * The interval is given by the 5th and 95th percentiles of the statistic over STAT_BOOT resamples with replacement
+ * (percentile bootstrap), no distribution of the samples is assumed. The seed is fixed, the CI is reproducible.
+ * It is not used for the mean: its CI is the Student t one, obtained from the CIs of the receive, the kernel and the
+ * consumer as the ci_* columns of the results file. The method is written as ci_method in the results files.
+ */
+double stat_boot_ci(const int stat, const int n, const double* data);
+
+/* the number of leading samples to discard as warmup, at most n/2.
+ * It is the truncation minimizing the standard error of the mean of the remaining samples (MSER rule)
+ */
+int stat_warmup(const int n, const double* data);
+
+#endif
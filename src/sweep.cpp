@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "sweep.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "tools.hpp"
+
+using std::string;
+using std::vector;
+
+//==============================================================================
+// remove the leading and trailing blanks
+static string trim(const string& str) {
+    const size_t start = str.find_first_not_of(" \t\r\n");
+    if (start == string::npos) {
+        return "";
+    }
+    const size_t end = str.find_last_not_of(" \t\r\n");
+    return str.substr(start, end - start + 1);
+}
+
+// split a comma-separated list, empty items are ignored
+static vector<string> split(const string& str) {
+    vector<string> list;
+    size_t         start = 0;
+    while (start <= str.size()) {
+        size_t end = str.find(',', start);
+        if (end == string::npos) {
+            end = str.size();
+        }
+        const string item = trim(str.substr(start, end - start));
+        if (!item.empty()) {
+            list.push_back(item);
+        }
+        start = end + 1;
+    }
+    return list;
+}
+
+// read an integer, `a<<b` is accepted
+static int to_int(const string& str) {
+    const size_t shift = str.find("<<");
+    if (shift != string::npos) {
+        return to_int(str.substr(0, shift)) << to_int(str.substr(shift + 2));
+    }
+    char*      end;
+    const long val = strtol(str.c_str(), &end, 10);
+    m_assert(end != str.c_str() && trim(end).empty(), "unable to read <%s> as an integer", str.c_str());
+    return (int)val;
+}
+
+//==============================================================================
+void Sweep::Default(const char* key, const char* value) {
+    if (std::find(order_.begin(), order_.end(), key) == order_.end()) {
+        order_.push_back(key);
+    }
+    if (keys_.find(key) == keys_.end()) {
+        keys_[key] = split(value);
+    }
+}
+
+void Sweep::Enum(const char* key, const vector<string>& names) {
+    enums_[key] = names;
+}
+
+void Sweep::Check() const {
+    for (const auto& it : keys_) {
+        m_assert(std::find(order_.begin(), order_.end(), it.first) != order_.end(), "unknown key <%s>", it.first.c_str());
+    }
+}
+
+void Sweep::Set_(const string& key, const string& value) {
+    keys_[key] = split(value);
+}
+
+void Sweep::ReadFile_(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    m_assert(file != nullptr, "unable to open the config file <%s>", filename);
+
+    char line[1024];
+    while (fgets(line, 1024, file)) {
+        // remove the comments
+        string str(line);
+        str = trim(str.substr(0, str.find('#')));
+        if (str.empty()) {
+            continue;
+        }
+        const size_t eq = str.find('=');
+        m_assert(eq != string::npos, "the line <%s> of <%s> must be `key = values`", str.c_str(), filename);
+        Set_(trim(str.substr(0, eq)), str.substr(eq + 1));
+    }
+    fclose(file);
+}
+
+void Sweep::Parse(int argc, char* argv[]) {
+    // the config file is read first so that the command line overwrites it
+    for (int i = 1; i < (argc - 1); ++i) {
+        if (strcmp(argv[i], "-config") == 0) {
+            ReadFile_(argv[i + 1]);
+        }
+    }
+    for (int i = 1; i < argc; ++i) {
+        m_assert(argv[i][0] == '-' && (i + 1) < argc, "arguments must be given as `-key values`, not <%s>", argv[i]);
+        if (strcmp(argv[i], "-config") != 0) {
+            Set_(argv[i] + 1, argv[i + 1]);
+        }
+        ++i;
+    }
+}
+
+//==============================================================================
+vector<int> Sweep::Ints(const char* key) const {
+    const auto it = keys_.find(key);
+    m_assert(it != keys_.end(), "unknown key <%s>", key);
+
+    vector<int> values;
+    const auto  names = enums_.find(key);
+    if (names != enums_.end()) {
+        for (const string& item : it->second) {
+            const auto name = std::find(names->second.begin(), names->second.end(), item);
+            m_assert(name != names->second.end(), "<%s> is not a valid value for <%s>", item.c_str(), key);
+            values.push_back(name - names->second.begin());
+        }
+        return values;
+    }
+    for (const string& item : it->second) {
+        const size_t col = item.find(':');
+        if (col == string::npos) {
+            values.push_back(to_int(item));
+            continue;
+        }
+        // we have a range or a dense set
+        const size_t col2  = item.find(':', col + 1);
+        const int    start = to_int(item.substr(0, col));
+        const int    end   = to_int(item.substr(col + 1, col2 - col - 1));
+        const string step  = (col2 == string::npos) ? "+1" : trim(item.substr(col2 + 1));
+        m_assert(step.size() > 1, "the step in <%s> must be `*step` or `+step`", item.c_str());
+        const int fact = to_int(step.substr(1));
+        if (step[0] == '*') {
+            m_assert(start > 0 && fact > 1, "the range <%s> would never end", item.c_str());
+            for (int val = start; val <= end; val *= fact) {
+                values.push_back(val);
+            }
+        } else {
+            m_assert(step[0] == '+' && fact > 0, "the step in <%s> must be `*step` or `+step`", item.c_str());
+            for (int val = start; val <= end; val += fact) {
+                values.push_back(val);
+            }
+        }
+    }
+    return values;
+}
+
+vector<string> Sweep::Names(const char* key) const {
+    const auto it = keys_.find(key);
+    m_assert(it != keys_.end(), "unknown key <%s>", key);
+    return it->second;
+}
+
+string Sweep::Name(const char* key, const int value) const {
+    const auto names = enums_.find(key);
+    if (names != enums_.end()) {
+        m_assert(0 <= value && value < (int)names->second.size(), "%d is not a valid value for <%s>", value, key);
+        return names->second[value];
+    }
+    return std::to_string(value);
+}
+
+vector<vector<int>> Sweep::Combine(const vector<string>& keys) const {
+    // start from the empty combination and add one dimension at a time
+    vector<vector<int>> space(1);
+    for (const string& key : keys) {
+        const vector<int>   values = Ints(key.c_str());
+        vector<vector<int>> next;
+        next.reserve(space.size() * values.size());
+        for (const vector<int>& point : space) {
+            for (const int val : values) {
+                next.push_back(point);
+                next.back().push_back(val);
+            }
+        }
+        space.swap(next);
+    }
+    return space;
+}
+
+void Sweep::Log() const {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank == 0) {
+        m_log("------------------------------------");
+        m_log("SWEEP");
+        for (const string& key : order_) {
+            string list;
+            for (const string& item : keys_.at(key)) {
+                list += (list.empty() ? "" : ",") + item;
+            }
+            m_log("\t%s = %s", key.c_str(), list.c_str());
+        }
+        m_log("------------------------------------");
+    }
+}
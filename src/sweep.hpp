@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef SWEEP_HPP_
+#define SWEEP_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+/* Runtime description of a parameter space
+ *
+ * Every key of the sweep holds a list of values, the parameter space is the cartesian product of the lists.
+ * The values are read from:
+ * - a config file given with `-config <file>`: one `key = v1,v2,...` per line, `#` starts a comment
+ * - the command line: `-key v1,v2,...` (has priority over the config file)
+ *
+ * An integer list is made of comma-separated items, each item being either
+ * - a single value: `5` or `1<<22`
+ * - a range set `start:end:*step`: `1:32:*2` gives 1, 2, 4, 8, 16, 32 (see m_range)
+ * - a dense set `start:end:+step`: `1:7:+2` gives 1, 3, 5, 7 (see m_dense), `1:4` is the same as `1:4:+1`
+ *
+ * The values of a key declared with Enum() are names, they are converted to their index in the list of names.
+ *
+ * Every key must be declared with Default(), before or after Parse(), Check() aborts on undeclared keys.
+ */
+class Sweep {
+    std::map<std::string, std::vector<std::string>> keys_;  // the raw (not expanded) values of every key
+    std::vector<std::string>                        order_; // the declared keys in declaration order
+    std::map<std::string, std::vector<std::string>> enums_; // the accepted names of the enum keys
+
+   public:
+    // declare a key and its default value, a value already read by Parse() is kept
+    void Default(const char* key, const char* value);
+    // the values of the key are names, Ints() returns their index in the list
+    void Enum(const char* key, const std::vector<std::string>& names);
+    // read the config file (if any) and the command line
+    void Parse(int argc, char* argv[]);
+    // abort if a key has been given but not declared
+    void Check() const;
+
+    // return the expanded values of a key
+    std::vector<int>         Ints(const char* key) const;
+    std::vector<std::string> Names(const char* key) const;
+    // return the name of a value given by Ints(): the name for an enum key, the integer otherwise
+    std::string Name(const char* key, const int value) const;
+
+    // return the cartesian product of the integer lists associated to the given keys
+    // the last key is the fastest varying one
+    std::vector<std::vector<int>> Combine(const std::vector<std::string>& keys) const;
+
+    // display the parameter space
+    void Log() const;
+
+   private:
+    void Set_(const std::string& key, const std::string& value);
+    void ReadFile_(const char* filename);
+};
+
+#endif
@@ -4,15 +4,18 @@
  */
 #include "test_part_bw.hpp"
 #include "mpi.h"
+#include "timer.hpp"
 #include "tools.hpp"
 #include "test_part_bw.hpp"
-#include <random>
 #include <omp.h>
-#include <sys/stat.h>
 #include <unistd.h>
 #include <climits>
 #include <map>
 #include <atomic>
+#include <cfloat>
+#include <cstring>
+
+TestPartOpt TestPartBw::opt_default_;
 
 #define MAX_RERUN 50
 #define THRESHOLD_RERUN 0.05
@@ -67,26 +70,219 @@ double t_nu_interp(const int nu) {
     //--------------------------------------------------------------------------
 }
 
-/* returns the noices (in permil)*/
-void TestPartBw::get_noise_(const int n_noise, double* noise_permil) {
-    //--------------------------------------------------------------------------
-    //  GET RANDOM NUMBERS GENERATOR
-    //--------------------------------------------------------------------------
-    std::random_device noise_rd{};
-    std::mt19937       noise_gen{noise_rd()};
+// the timings of one rank, gathered on rank 0 as doubles
+typedef struct PartRankTime {
+    double t_zero       = 0.0;  // mean time of the transfer
+    double s_zero       = 0.0;  // std of the time of the transfer
+    double t_cmpt       = 0.0;  // mean time of the kernel and the noise (sender) or of the consumer (receiver)
+    double s_cmpt       = 0.0;  // std of the time of the kernel and the noise (sender) or of the consumer (receiver)
+    double tl_metric[3] = {0.0, 0.0, 0.0};  // the early-bird metrics, see Timeline_()
+    double t_pipeline   = 0.0;  // the end-to-end pipeline time, see Pipeline_()
+    double t_stat[STAT_N] = {0.0};  // the statistics of the time of the pair, see Stats_()
+    double ci_stat        = 0.0;    // the bootstrap CI of the selected statistic, see Stats_()
+} PartRankTime;
 
-    // on average there are no noise but the std is given as a percentage
-    const double noise_mean = 0.0;  // on average no noise
-    const double noise_std  = 0.001 * noise_lvl;
+// get the CI for the difference of two means following:
+// https://sphweb.bumc.bu.edu/otlt/mph-modules/bs/bs704_confidence_intervals/bs704_confidence_intervals5.html
+// with n1 = n2 = n_repeat
+static double diff_ci(const double s_ref, const double s_cmpt, const int n_repeat) {
+    const double t_nu_diff = t_nu_interp(2 * n_repeat - 2);
+    const double s_p       = sqrt(0.5 * (pow(s_ref, 2) + pow(s_cmpt, 2)));
+    return t_nu_diff * s_p * sqrt(2.0 / n_repeat);
+}
 
-    // get a normal distributed noise
-    std::normal_distribution<double> noise{noise_mean, noise_std};
+/* one transfer from the sender to the receiver using the hooks of test, to be called by every thread.
+ * On the sender side, each partition is produced by the kernel and then sleeps for its delay (if delay is not null)
+ * before being ready.
+ * On the receiver side, each partition is consumed once it has arrived, or once the communication has completed if
+ * the strategy cannot detect the arrival of a partition (see PartArrival()).
+ * If t_event is not null, the time since t_start at which each partition is ready (sender)
+ * or has arrived (receiver) is stored in it.
+ * If t_pipe is not null, the time since t_start of the first Pready of the thread (sender)
+ * or of the end of its last consumed partition (receiver) is stored in it.
+ * Returns the time spent by the calling thread in the kernel and in the noise (sender) or in the consumer (receiver)
+ */
+double TestPartBw::Transfer_(TestPartBw* test, const bool sender, const TestPartInfo* info, const int kernel,
+                             const int consume, const double* delay, const double t_start, double* t_event,
+                             double* t_pipe) {
+    double cmpt = 0.0;
+    //..................................................................
+    // SEND
+    if (sender) {
+        test->Send_StartPreCompute();
+        // NO BARRIER - done in Send_StartPreCompute
+#pragma omp for schedule(static) nowait
+        for (int ip = 0; ip < n_part; ip++) {
+            // compute the partition
+            if (kernel != part_kernel_none) {
+                const size_t offset   = ip * info->size.per_part;
+                const double cmpt_tic = PartTimer::Now();
+                kernel_produce(kernel, info->size.per_part, info->buf + offset, kernel_aux_[0] + offset, kernel_aux_[1] + offset);
+                cmpt += PartTimer::Now() - cmpt_tic;
+            }
+            // apply the noise to get the early bird behavior
+            if (delay && delay[ip] > 0.0) {
+                cmpt += noise_spin(delay[ip]);
+            }
+            // partition is ready
+            if (t_event) {
+                t_event[ip] = PartTimer::Now() - t_start;
+            }
+            if (t_pipe) {
+                *t_pipe = m_min(*t_pipe, PartTimer::Now() - t_start);
+            }
+            test->Send_Pready(ip);
+        }
+        // NO BARRIER - done in Send_StartPostCompute
+        // finalize
+        test->Send_StartPostCompute();
+    }
+    //..................................................................
+    // RECV
+    if (!sender) {
+        test->Recv_StartPreCompute();
+        // NO BARRIER - done in Send_StartPreCompute
+#pragma omp for schedule(static) nowait
+        for (int ip = 0; ip < n_part; ip++) {
+            test->Recv_Pready(ip);
+            if (t_event) {
+                t_event[ip] = PartTimer::Now() - t_start;
+            }
+            if (consume != part_consume_none && test->PartArrival()) {
+                const size_t offset   = ip * info->size.per_part;
+                const double cons_tic = PartTimer::Now();
+                kernel_consume(consume, info->size.per_part, test->RecvPart(info, ip), consume_out_ + offset);
+                cmpt += PartTimer::Now() - cons_tic;
+            }
+        }
+        // NO BARRIER - done in Send_StartPreCompute
+        test->Recv_StartPostCompute();
+        if (consume != part_consume_none && !test->PartArrival()) {
+            // the completion might have been done by the master only
+#pragma omp barrier
+#pragma omp for schedule(static) nowait
+            for (int ip = 0; ip < n_part; ip++) {
+                const size_t offset   = ip * info->size.per_part;
+                const double cons_tic = PartTimer::Now();
+                kernel_consume(consume, info->size.per_part, test->RecvPart(info, ip), consume_out_ + offset);
+                cmpt += PartTimer::Now() - cons_tic;
+            }
+        }
+        if (t_pipe) {
+            *t_pipe = PartTimer::Now() - t_start;
+        }
+    }
+    return cmpt;
+}
 
-    // fill the buffer with random percentages
-    for (int it = 0; it < n_noise; ++it) {
-        // no negative number here
-        noise_permil[it] = fabs(noise(noise_gen));
+/* compute the early-bird metrics from the timeline of the measured iterations, on the sender side only.
+ * the receiver sends its arrival and completion times to the sender, the times of both ranks are relative to the
+ * end of the barrier starting the iteration (the skew between the ranks is the one of MPI_Barrier).
+ * metric[0] = the spread of the ready times: last Pready - first Pready
+ * metric[1] = the time from the last Pready to the completion on the receiver
+ * metric[2] = the fraction of the bytes received when the last partition becomes ready
+ */
+void TestPartBw::Timeline_(const bool sender, const int buddy, const int i_first, const int n_iter,
+                           const double* t_event, const double* t_done, double* metric) {
+    if (!sender) {
+        MPI_Send(t_event, n_iter * n_part, MPI_DOUBLE, buddy, 407, MPI_COMM_WORLD);
+        MPI_Send(t_done, n_iter, MPI_DOUBLE, buddy, 408, MPI_COMM_WORLD);
+        return;
     }
+    double* t_arrive = (double*)malloc(n_iter * n_part * sizeof(double));
+    double* t_recv   = (double*)malloc(n_iter * sizeof(double));
+    MPI_Recv(t_arrive, n_iter * n_part, MPI_DOUBLE, buddy, 407, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    MPI_Recv(t_recv, n_iter, MPI_DOUBLE, buddy, 408, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+    metric[0] = 0.0;
+    metric[1] = 0.0;
+    metric[2] = 0.0;
+    for (int iter = i_first; iter < n_iter; ++iter) {
+        const double* t_ready = t_event + iter * n_part;
+        double        r_min   = t_ready[0];
+        double        r_max   = t_ready[0];
+        for (int ip = 1; ip < n_part; ++ip) {
+            r_min = m_min(r_min, t_ready[ip]);
+            r_max = m_max(r_max, t_ready[ip]);
+        }
+        // all the partitions have the same size
+        int n_early = 0;
+        for (int ip = 0; ip < n_part; ++ip) {
+            n_early += (t_arrive[iter * n_part + ip] <= r_max);
+        }
+        metric[0] += r_max - r_min;
+        metric[1] += t_recv[iter] - r_max;
+        metric[2] += (double)n_early / n_part;
+    }
+    metric[0] /= (n_iter - i_first);
+    metric[1] /= (n_iter - i_first);
+    metric[2] /= (n_iter - i_first);
+    free(t_arrive);
+    free(t_recv);
+}
+
+/* compute the end-to-end pipeline time of the measured iterations, on the sender side only.
+ * t_pipe is the first Pready of the iteration on the sender and the end of the last consumer on the receiver,
+ * both relative to the end of the barrier starting the iteration.
+ */
+double TestPartBw::Pipeline_(const bool sender, const int buddy, const int i_first, const int n_iter,
+                             const double* t_pipe) {
+    if (!sender) {
+        MPI_Send(t_pipe, n_iter, MPI_DOUBLE, buddy, 409, MPI_COMM_WORLD);
+        return 0.0;
+    }
+    double* t_consumed = (double*)malloc(n_iter * sizeof(double));
+    MPI_Recv(t_consumed, n_iter, MPI_DOUBLE, buddy, 409, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    double time = 0.0;
+    for (int iter = i_first; iter < n_iter; ++iter) {
+        time += t_consumed[iter] - t_pipe[iter];
+    }
+    free(t_consumed);
+    return time / (n_iter - i_first);
+}
+
+/* compute the statistics of the time of the measured iterations, on the sender side only.
+ * the time of an iteration is the one of the receiver (of the sender for the ping-pong, halved) minus the time spent
+ * in the kernel and in the noise by the sender and in the consumer by the receiver, its mean is the reported time of
+ * the default statistic.
+ * value[STAT_N] gets every statistic, returns the bootstrap CI of the selected one (0 for the mean)
+ */
+double TestPartBw::Stats_(const bool sender, const int buddy, const int i_first, const int n_iter,
+                          const double* t0_data, const double* t0_cmpt_data, double* value) {
+    const int  n_meas   = n_iter - i_first;
+    const bool pingpong = (opt_.mode == part_mode_pingpong);
+    if (!sender) {
+        if (!pingpong) {
+            MPI_Send(t0_data, n_iter, MPI_DOUBLE, buddy, 410, MPI_COMM_WORLD);
+        }
+        MPI_Send(t0_cmpt_data, n_iter, MPI_DOUBLE, buddy, 411, MPI_COMM_WORLD);
+        return 0.0;
+    }
+    double* t_ref  = (double*)malloc(n_iter * sizeof(double));
+    double* t_cons = (double*)malloc(n_iter * sizeof(double));
+    MPI_Recv(t_cons, n_iter, MPI_DOUBLE, buddy, 411, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    if (pingpong) {
+        memcpy(t_ref, t0_data, n_iter * sizeof(double));
+    } else {
+        MPI_Recv(t_ref, n_iter, MPI_DOUBLE, buddy, 410, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    }
+    const double factor = pingpong ? 0.5 : 1.0;
+    double*      sample = (double*)malloc(n_meas * sizeof(double));
+    for (int iter = i_first; iter < n_iter; ++iter) {
+        sample[iter - i_first] = factor * (t_ref[iter] - t0_cmpt_data[iter] - t_cons[iter]);
+    }
+    stat_all(n_meas, sample, value);
+    const double ci = (opt_.stat == part_stat_mean) ? 0.0 : stat_boot_ci(opt_.stat, n_meas, sample);
+    free(sample);
+    free(t_ref);
+    free(t_cons);
+    return ci;
+}
+
+// allocate a buffer of size bytes, from the arena if any
+void* TestPartBw::Alloc_(const int slot, const size_t size) {
+    const size_t max_size = (size_t)max_count * sizeof(double);
+    return PartArena::Get(opt_.arena, slot, size, max_size, opt_.page, opt_.align);
 }
 
 void TestPartBw::run() {
@@ -102,27 +298,79 @@ void TestPartBw::run() {
         MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
     }
     const int buddy = get_friend(rank,comm_size);
+    const int n_pair = comm_size / 2;
+    const bool pingpong = (opt_.mode == part_mode_pingpong);
+    m_assert(!pingpong || pong_ != nullptr, "the ping-pong mode requires a test for the way back, see SetPong()");
 
     //--------------------------------------------------------------------------
-    char foldr_name [512] = "results";
-    char fullname[512];
-
-    // pre-open the file to clean it up
+    // the results files, written by rank 0
+    PartOutput* out       = nullptr;  // the time of every size
+    PartOutput* out_setup = nullptr;  // the setup cost, see RequestInit() and RequestCleanup()
+    PartOutput* out_stat  = nullptr;  // the statistics of the per-iteration times
+    PartOutput* out_tl    = nullptr;  // the early-bird metrics if opt_.timeline
+    PartOutput* out_pipe  = nullptr;  // the end-to-end pipeline time if opt_.consume
+    PartOutput* out_pair  = nullptr;  // every pair if there is more than one
+    PartOutput* out_node  = nullptr;  // every node if there is more than one pair
     if (rank == 0) {
         char filename[512];
         FileName(512, filename);
-        snprintf(fullname, 512, "%s/%s", foldr_name, filename);
-
-        // test and create the dir if needed
-        struct stat st = {0};
-        if (rank == 0 && stat(foldr_name, &st) == -1) {
-            mkdir(foldr_name, 0770);
+        // the strategy and its parameters, then the partitions
+        part_meta_t meta = opt_.meta;
+        meta.push_back({"n_threads", std::to_string(n_threads)});
+        meta.push_back({"n_part", std::to_string(n_part)});
+        meta.push_back({"ci_method", (opt_.stat == part_stat_mean) ? "student_t" : "bootstrap"});
+        auto open = [&](const char* prefix, const std::vector<part_col_t>& cols) {
+            char name[1024];
+            snprintf(name, 1024, "results/%s%s%s", prefix, pingpong ? "pingpong_" : "", filename);
+            return new PartOutput(name, meta, cols);
+        };
+        out = open("", {{"size", true},
+                        {"t_send", false},
+                        {"t_recv", false},
+                        {"t_cmpt", false},
+                        {"time", false},
+                        {"ci_send", false},
+                        {"ci_recv", false},
+                        {"ci_cmpt", false},
+                        {"ci_time", false},
+                        {"t_consume", false},
+                        {"ci_consume", false}});
+        out_setup = open("setup_", {{"size", true}, {"init", false}, {"cleanup", false}, {"iteration", false},
+                                    {"break_even", false}});
+        out_stat  = open("stats_", {{"size", true}, {"mean", false}, {"median", false}, {"p90", false},
+                                    {"p99", false}, {"p999", false}, {"trim", false}});
+        if (opt_.timeline) {
+            out_tl = open("timeline_", {{"size", true}, {"ready_spread", false}, {"last_ready_to_done", false},
+                                        {"recv_at_last_ready", false}});
+        }
+        if (opt_.consume != part_consume_none) {
+            out_pipe = open("pipeline_", {{"size", true}, {"t_pipeline", false}});
+        }
+        if (n_pair > 1) {
+            out_pair = open("pairs_", {{"size", true}, {"pair", true}, {"node", true}, {"time", false},
+                                       {"ci", false}, {"bw", false}});
+            out_node = open("node_", {{"size", true}, {"node", true}, {"n_pair", true}, {"bw", false}});
         }
-        FILE* file;
-        file = fopen(fullname, "w+");
-        fclose(file);
     }
 
+    // a node is identified by the lowest rank it hosts, rank 0 gets the node of every sender
+    int*      node_id = (int*)malloc(comm_size * sizeof(int));
+    MPI_Comm  node_comm;
+    int       node_rank;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+    MPI_Allreduce(&rank, &node_rank, 1, MPI_INT, MPI_MIN, node_comm);
+    MPI_Comm_free(&node_comm);
+    MPI_Gather(&node_rank, 1, MPI_INT, node_id, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+    // the timings of every rank and of every pair, on rank 0
+    PartRankTime* all_time  = (PartRankTime*)malloc(comm_size * sizeof(PartRankTime));
+    double*       pair_time = (double*)malloc(n_pair * sizeof(double));
+    double*       pair_ci   = (double*)malloc(n_pair * sizeof(double));
+
+    // the noise is drawn for every iteration, outside of the timed region
+    PartNoise noise(opt_.noise_model, n_part, n_threads, opt_.noise_trace.c_str());
+    double*   delay = (double*)malloc(n_part * sizeof(double));
+
     // the minimum total size is n_part as it means 1 element per partition
     for (size_t test_size = n_part; test_size <= max_count; test_size *= 2) {
         // get the sizes
@@ -131,90 +379,138 @@ void TestPartBw::run() {
         info.size.per_part  = test_size / n_part;
         info.size.bandwidth = test_size * sizeof(double*);
 
-        // allocate the send buffer and the noise
-        info.buf = (double*)malloc(info.size.per_rank * sizeof(double));
-        // init the communication
+        // allocate the buffers, each partition is first touched by the thread which owns it
+        const size_t buf_size = info.size.per_rank * sizeof(double);
+        info.buf = (double*)Alloc_(part_slot_buf, buf_size);
+        part_first_touch(info.buf, info.size.per_part, n_part, 0.0);
+        // the input arrays of the kernels, initialized by the thread computing the partition
+        if (opt_.kernel == part_kernel_triad || opt_.kernel == part_kernel_stencil) {
+            kernel_aux_[0] = (double*)Alloc_(part_slot_aux0, buf_size);
+            kernel_aux_[1] = (double*)Alloc_(part_slot_aux1, buf_size);
+#pragma omp parallel for schedule(static)
+            for (int ip = 0; ip < n_part; ++ip) {
+                for (size_t i = ip * info.size.per_part; i < (ip + 1) * info.size.per_part; ++i) {
+                    kernel_aux_[0][i] = 1.0 + i % 7;
+                    kernel_aux_[1][i] = 2.0 + i % 5;
+                }
+            }
+        }
+        // the output array of the consumers, initialized by the thread consuming the partition
+        if (opt_.consume != part_consume_none) {
+            consume_out_ = (double*)Alloc_(part_slot_out, buf_size);
+            part_first_touch(consume_out_, info.size.per_part, n_part, 0.0);
+        }
+        // init the communication, the way back of the ping-pong uses the same buffer
+        // the setup is timed from a barrier, its cost is the one of the slowest rank
+        MPI_Barrier(MPI_COMM_WORLD);
+        double t_setup[2];
+        t_setup[0] = PartTimer::Now();
         RequestInit(&info);
-
-        // get the overhead of MPI_Wtime() and decide to apply some noise or not
-        const double threshold_start = MPI_Wtime();
-        for (int i = 0; i < 1000; ++i) {
-            MPI_Wtime();
+        if (pingpong) {
+            pong_->RequestInit(&info);
         }
-        const double threshold_end   = MPI_Wtime();
-        const double noise_threshold = (threshold_end - threshold_start) / (1000 + 2);
-        // we iterate on the MPI_Wtime if calling 4 times Wtime() is faster than the time we have to
-        // wait. the factor 4 comes from the number of times we have to call the function to
-        // successfully measure the sleep
-        const double noise_time = 1.0e-12 * noise_lvl * (info.size.per_part * sizeof(double));
-        const bool   do_noise   = (noise_time > (3.0 * noise_threshold));
+        t_setup[0] = PartTimer::Now() - t_setup[0];
+
+        // the scale of the noise for one partition
+        const double noise_scale = (opt_.noise_model == part_noise_trace)
+                                       ? 1.0e-2 * noise_lvl
+                                       : 1.0e-12 * noise_lvl * (info.size.per_part * sizeof(double));
 
         //----------------------------------------------------------------------
         //  SEND - RECV
         //----------------------------------------------------------------------
-        const bool sender = is_sender(rank, comm_size);
+        const bool sender = IsSender();
         int        rerun  = 0;
+        double     t_step = 0.0;  // the time of one iteration, as reported
+        // the timings of every iteration, kept across the rounds by the adaptive sampling
+        const bool   adaptive     = (opt_.sampling == part_sampling_adaptive);
+        const double t_budget     = PartTimer::Now();  // the start of the sampling of the size
+        int          n_iter       = 0;
+        double*      t0_data      = nullptr;
+        double*      t0_cmpt_data = nullptr;
+        // the timeline: ready (sender) or arrival (receiver) time of every partition and completion time
+        double* t_event = nullptr;
+        double* t_done  = nullptr;
+        // the pipeline: first Pready (sender) or end of the last consumer (receiver)
+        double* t_pipe = nullptr;
+        // the time of the iteration and in the kernel and the noise of every thread, for the raw samples
+        double* t_thread = nullptr;
+        double* c_thread = nullptr;
+        int     i_first  = n_warmup;
         do {
-            double* t0_data      = (double*)calloc((n_repeat + n_warmup), sizeof(double));
-            double* t0_cmpt_data = (double*)calloc((n_repeat + n_warmup), sizeof(double));
+            // a rerun starts over, the adaptive sampling adds n_repeat iterations to the previous ones
+            if (!adaptive) {
+                n_iter = 0;
+            }
+            const int i_begin = n_iter;
+            n_iter += (i_begin == 0) ? (n_warmup + n_repeat) : n_repeat;
+            t0_data      = (double*)realloc(t0_data, n_iter * sizeof(double));
+            t0_cmpt_data = (double*)realloc(t0_cmpt_data, n_iter * sizeof(double));
+            if (opt_.timeline) {
+                t_event = (double*)realloc(t_event, n_iter * n_part * sizeof(double));
+                t_done  = (double*)realloc(t_done, n_iter * sizeof(double));
+            }
+            if (opt_.consume != part_consume_none) {
+                t_pipe = (double*)realloc(t_pipe, n_iter * sizeof(double));
+            }
+            if (PartRaw::Enabled()) {
+                t_thread = (double*)realloc(t_thread, n_iter * n_threads * sizeof(double));
+                c_thread = (double*)realloc(c_thread, n_iter * n_threads * sizeof(double));
+            }
 
-            for (int iter = 0; iter < (n_repeat + n_warmup); ++iter) {
+            for (int iter = i_begin; iter < n_iter; ++iter) {
                 // iteration specific timers
                 double t0      = 0.0;
                 double t0_cmpt = 0.0;
+                double t0_end  = 0.0;
+                double t0_first = DBL_MAX;  // the first Pready of the sender
+                double t0_last  = 0.0;      // the end of the last consumer of the receiver
+
+                // only the sender is delayed, the way back of the ping-pong is not
+                const double* t_delay = (sender && noise_lvl > 0) ? delay : nullptr;
+                if (t_delay) {
+                    noise.Draw(noise_scale, delay);
+                }
 
                 MPI_Barrier(MPI_COMM_WORLD);
+                const double t_start = PartTimer::Now();
+                double*      t_iter  = (t_event) ? (t_event + iter * n_part) : nullptr;
                 //======================================================================================
                 // BEGIN PARALLEL REGION
                 //======================================================================================
-#pragma omp parallel reduction(max : t0, t0_cmpt)
+#pragma omp parallel reduction(max : t0, t0_cmpt, t0_end, t0_last) reduction(min : t0_first)
                 {
-                    double t0_tic   = 0.0;
+                    double t0_tic  = 0.0;
                     double t0_toc  = 0.0;
-                    double cmpt_tic = 0.0;
-                    double cmpt_toc = 0.0;
+                    double cmpt    = 0.0;
+                    double pipe    = sender ? DBL_MAX : 0.0;
                     //..................................................................
 #pragma omp barrier
-                    t0_tic = MPI_Wtime();
+                    t0_tic = PartTimer::Now();
                     //..................................................................
-                    // SEND
-                    if (sender) {
-                        Send_StartPreCompute();
-                        // NO BARRIER - done in Send_StartPreCompute
-#pragma omp for schedule(static) nowait
-                        for (int ip = 0; ip < n_part; ip++) {
-                            // only the last partition sleeps to get the early bird behavior
-                            if (ip == n_part - 1 && do_noise) {
-                                cmpt_tic = MPI_Wtime();
-                                while ((MPI_Wtime() - cmpt_tic) < noise_time) {
-                                    // do nothing
-                                };
-                                cmpt_toc = MPI_Wtime();
-                            }
-                            // partition is ready
-                            Send_Pready(ip);
-                        }
-                        // NO BARRIER - done in Send_StartPostCompute
-                        // finalize
-                        Send_StartPostCompute();
+                    cmpt = Transfer_(this, sender, &info, opt_.kernel, opt_.consume, t_delay, t_start, t_iter,
+                                     t_pipe ? &pipe : nullptr);
+                    if (t_iter) {
+                        t0_end = PartTimer::Now() - t_start;
                     }
-                    //..................................................................
-                    // RECV
-                    if (!sender) {
-                        Recv_StartPreCompute();
-                        // NO BARRIER - done in Send_StartPreCompute
-#pragma omp for schedule(static) nowait
-                        for (int ip = 0; ip < n_part; ip++) {
-                            Recv_Pready(ip);
-                        }
-                        // NO BARRIER - done in Send_StartPreCompute
-                        Recv_StartPostCompute();
+                    if (opt_.mode == part_mode_pingpong) {
+                        // the way back is the echo of the received data, no kernel and no noise are applied
+                        Transfer_(pong_, !sender, &info, part_kernel_none, part_consume_none, nullptr, t_start, nullptr,
+                                  nullptr);
                     }
                     //..................................................................
-                    t0_toc = MPI_Wtime();
+                    t0_toc = PartTimer::Now();
 #pragma omp barrier
                     t0      = m_max(t0_toc - t0_tic, t0);
-                    t0_cmpt = m_max(cmpt_toc - cmpt_tic, t0_cmpt);
+                    t0_cmpt = m_max(cmpt, t0_cmpt);
+                    if (t_thread) {
+                        t_thread[iter * n_threads + omp_get_thread_num()] = t0_toc - t0_tic;
+                        c_thread[iter * n_threads + omp_get_thread_num()] = cmpt;
+                    }
+                    if (t_pipe) {
+                        t0_first = sender ? m_min(pipe, t0_first) : t0_first;
+                        t0_last  = sender ? t0_last : m_max(pipe, t0_last);
+                    }
                     //..................................................................
                 }
                 //======================================================================================
@@ -224,100 +520,248 @@ void TestPartBw::run() {
                 // store the timings
                 t0_data[iter]      = t0;
                 t0_cmpt_data[iter] = t0_cmpt;
+                if (t_pipe) {
+                    t_pipe[iter] = sender ? t0_first : t0_last;
+                }
+                if (t_done) {
+                    t_done[iter] = t0_end;
+                    // without arrival notification, the partitions arrive at the completion
+                    if (!sender && !PartArrival()) {
+                        for (int ip = 0; ip < n_part; ++ip) {
+                            t_iter[ip] = t0_end;
+                        }
+                    }
+                }
             }
             //..........................................................................................
+            // the measured iterations: after n_warmup or, for the adaptive sampling, after the warmup detected
+            // on the times of every rank
+            i_first = n_warmup;
+            if (adaptive) {
+                const int i_warm = n_warmup + stat_warmup(n_iter - n_warmup, t0_data + n_warmup);
+                MPI_Allreduce(&i_warm, &i_first, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+            }
+            const int n_meas = n_iter - i_first;
             // local timers and local stds
-            double t_zero_local = 0.0;
-            double t_cmpt_local = 0.0;
+            PartRankTime local;
+            // get the early-bird metrics
+            if (opt_.timeline) {
+                Timeline_(sender, buddy, i_first, n_iter, t_event, t_done, local.tl_metric);
+            }
+            // get the end-to-end pipeline time
+            if (t_pipe) {
+                local.t_pipeline = Pipeline_(sender, buddy, i_first, n_iter, t_pipe);
+            }
+            // get the statistics of the pair
+            local.ci_stat = Stats_(sender, buddy, i_first, n_iter, t0_data, t0_cmpt_data, local.t_stat);
             // first get the means
-            for (int i = n_warmup; i < (n_repeat + n_warmup); ++i) {
-                t_zero_local += t0_data[i];
-                t_cmpt_local += t0_cmpt_data[i];
+            for (int i = i_first; i < n_iter; ++i) {
+                local.t_zero += t0_data[i];
+                local.t_cmpt += t0_cmpt_data[i];
             }
-            t_zero_local /= n_repeat;
-            t_cmpt_local /= n_repeat;
+            local.t_zero /= n_meas;
+            local.t_cmpt /= n_meas;
             // then the std
-            double s_zero_local = 0.0;
-            double s_cmpt_local = 0.0;
-            for (int i = n_warmup; i < (n_repeat + n_warmup); ++i) {
-                s_zero_local += pow(t0_data[i] - t_zero_local, 2);
-                s_cmpt_local += pow(t0_cmpt_data[i] - t_cmpt_local, 2);
+            for (int i = i_first; i < n_iter; ++i) {
+                local.s_zero += pow(t0_data[i] - local.t_zero, 2);
+                local.s_cmpt += pow(t0_cmpt_data[i] - local.t_cmpt, 2);
             }
-            s_zero_local = sqrt(s_zero_local / (n_repeat - 1));
-            s_cmpt_local = sqrt(s_cmpt_local / (n_repeat - 1));
-            // free useless data
-            free(t0_data);
-            free(t0_cmpt_data);
+            local.s_zero = sqrt(local.s_zero / (n_meas - 1));
+            local.s_cmpt = sqrt(local.s_cmpt / (n_meas - 1));
             //..................................................................
-            // get different comms for the sender and receivers
-            int      color = is_sender(rank, comm_size);
-            MPI_Comm new_comm;
-            MPI_Comm_split(MPI_COMM_WORLD, color, rank, &new_comm);
-            int new_comm_size;
-            MPI_Comm_size(new_comm, &new_comm_size);
-
-            double t_zero, t_cmpt, std_zero, std_cmpt;
-            MPI_Reduce(&t_zero_local, &t_zero, 1, MPI_DOUBLE, MPI_SUM, 0, new_comm);
-            MPI_Reduce(&s_zero_local, &std_zero, 1, MPI_DOUBLE, MPI_SUM, 0, new_comm);
-            MPI_Reduce(&t_cmpt_local, &t_cmpt, 1, MPI_DOUBLE, MPI_SUM, 0, new_comm);
-            MPI_Reduce(&s_cmpt_local, &std_cmpt, 1, MPI_DOUBLE, MPI_SUM, 0, new_comm);
-            t_zero /= (new_comm_size);
-            t_cmpt /= (new_comm_size);
-            std_zero /= (new_comm_size);
-            std_cmpt /= (new_comm_size);
-            MPI_Comm_free(&new_comm);
+            // every rank sends its timings to rank 0, the senders are the first half of the ranks
+            constexpr int n_val = sizeof(PartRankTime) / sizeof(double);
+            MPI_Gather(&local, n_val, MPI_DOUBLE, all_time, n_val, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 
-            //..................................................................
             if (rank == 0) {
-                double t_recv, std_recv;
-                MPI_Recv(&t_recv, 1, MPI_DOUBLE, 1, 404, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                MPI_Recv(&std_recv, 1, MPI_DOUBLE, 1, 405, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
                 // get the memory in B
                 const size_t memory = info.size.bandwidth;
+                // the bandwidth uses the time of the receiver, the ping-pong uses half the round trip of the sender
+                const double factor = pingpong ? 0.5 : 1.0;
+
+                // the timings of every pair, the worst CI decides if we rerun
+                double ci_worst = 0.0;
+                for (int ip = 0; ip < n_pair; ++ip) {
+                    const PartRankTime* send = all_time + ip;
+                    const PartRankTime* recv = all_time + ip + n_pair;
+                    const double        t_ref = pingpong ? send->t_zero : recv->t_zero;
+                    const double        s_ref = pingpong ? send->s_zero : recv->s_zero;
+                    // the kernel of the sender and the consumer of the receiver are not communication
+                    pair_time[ip] = factor * (t_ref - send->t_cmpt - recv->t_cmpt);
+                    pair_ci[ip]   = factor * diff_ci(s_ref, sqrt(pow(send->s_cmpt, 2) + pow(recv->s_cmpt, 2)), n_meas);
+                    if (opt_.stat != part_stat_mean) {
+                        pair_time[ip] = send->t_stat[opt_.stat];
+                        pair_ci[ip]   = send->ci_stat;
+                    }
+                    ci_worst      = m_max(ci_worst, pair_ci[ip] / pair_time[ip]);
+                }
+
+                // the average over the senders and over the receivers
+                PartRankTime avg_send, avg_recv;
+                for (int ip = 0; ip < n_pair; ++ip) {
+                    const double* send = (const double*)(all_time + ip);
+                    const double* recv = (const double*)(all_time + ip + n_pair);
+                    for (int iv = 0; iv < n_val; ++iv) {
+                        ((double*)&avg_send)[iv] += send[iv] / n_pair;
+                        ((double*)&avg_recv)[iv] += recv[iv] / n_pair;
+                    }
+                }
+                const double t_zero   = avg_send.t_zero;
+                const double std_zero = avg_send.s_zero;
+                const double t_cmpt   = avg_send.t_cmpt;
+                const double std_cmpt = avg_send.s_cmpt;
+                const double t_recv   = avg_recv.t_zero;
+                const double std_recv = avg_recv.s_zero;
+                const double t_cons   = avg_recv.t_cmpt;  // the time of the receiver in the consumer
+                const double std_cons = avg_recv.s_cmpt;
 
                 // get the individual 90% confidence intervals (CI)
-                const double t_nu_val = t_nu_interp(n_repeat);
-                const double ci_zero  = std_zero * t_nu_val * sqrt(1.0 / n_repeat);
-                const double ci_recv  = std_recv * t_nu_val * sqrt(1.0 / n_repeat);
-                const double ci_cmpt  = std_cmpt * t_nu_val * sqrt(1.0 / n_repeat);
-                // get the CI for the difference of two means following:
-                // https://sphweb.bumc.bu.edu/otlt/mph-modules/bs/bs704_confidence_intervals/bs704_confidence_intervals5.html
-                // with n1 = n2 = n_repeat
-                const double time      = t_recv - t_cmpt;
-                const double t_nu_diff = t_nu_interp(2 * n_repeat - 2);
-                const double s_p       = sqrt(0.5 * (pow(std_recv, 2) + pow(std_cmpt, 2)));
-                const double ci_time   = t_nu_diff * s_p * sqrt(2.0 / n_repeat);
+                const double t_nu_val = t_nu_interp(n_meas);
+                const double ci_zero  = std_zero * t_nu_val * sqrt(1.0 / n_meas);
+                const double ci_recv  = std_recv * t_nu_val * sqrt(1.0 / n_meas);
+                const double ci_cmpt  = std_cmpt * t_nu_val * sqrt(1.0 / n_meas);
+                const double ci_cons  = std_cons * t_nu_val * sqrt(1.0 / n_meas);
+                const double t_ref    = pingpong ? t_zero : t_recv;
+                const double s_ref    = pingpong ? std_zero : std_recv;
+                const bool   mean     = (opt_.stat == part_stat_mean);
+                const double s_sub    = sqrt(pow(std_cmpt, 2) + pow(std_cons, 2));
+                const double time     = mean ? factor * (t_ref - t_cmpt - t_cons) : avg_send.t_stat[opt_.stat];
+                const double ci_time  = mean ? factor * diff_ci(s_ref, s_sub, n_meas) : avg_send.ci_stat;
 
                 // we are a sender
                 const double bw = ((double)memory / 1.0e+9) / (time);
 
-                if (ci_time / time > THRESHOLD_RERUN && rerun < (MAX_RERUN-1)) {
+                // the adaptive sampling also stops once the time budget of the size is spent
+                const bool budget_left = !adaptive || (PartTimer::Now() - t_budget) < opt_.budget;
+                if (ci_worst > THRESHOLD_RERUN && rerun < (MAX_RERUN-1) && budget_left) {
                     rerun++;
-                    MPI_Send(&rerun, 1, MPI_INT, 1, 406, MPI_COMM_WORLD);
-                    m_log("\t%f KB - %.2f +- %.2f [usec]- %f [GB/s] -> (%.2f%%) retry %d/%d", (double)memory * 1.0e-3, time * 1e+6, ci_time * 1e+6, bw,ci_time/time*100.0,rerun,MAX_RERUN);
+                    m_log("\t%f KB - %.2f +- %.2f [usec]- %f [GB/s] -> (%.2f%%) retry %d/%d - %d samples", (double)memory * 1.0e-3, time * 1e+6, ci_time * 1e+6, bw,ci_worst*100.0,rerun,MAX_RERUN,n_meas);
                 } else {
                     rerun = (MAX_RERUN * 2);
-                    MPI_Send(&rerun, 1, MPI_INT, 1, 406, MPI_COMM_WORLD);
-                    m_log("%f KB - %.2f +- %.2f [usec]- %f [GB/s] - send = %e, recv = %e -> (%.2f%%)", (double)memory * 1.0e-3, time * 1e+6, ci_time * 1e+6,bw,(t_zero-t_cmpt)*1e+6,(t_recv-t_cmpt)*1e+6, ci_time/time*100.0);
+                    t_step = time;
+                    m_log("%f KB - %.2f +- %.2f [usec]- %f [GB/s] - send = %e, recv = %e -> (%.2f%%)", (double)memory * 1.0e-3, time * 1e+6, ci_time * 1e+6,bw,(t_zero-t_cmpt)*1e+6,(t_recv-t_cmpt-t_cons)*1e+6, ci_time/time*100.0);
                     //  print to file
-                    FILE* file;
-                    file = fopen(fullname, "a+");
-                    fprintf(file, "%ld,%e,%e,%e,%e,%e,%e,%e,%e\n", memory, t_zero, t_recv, t_cmpt, time, ci_zero, ci_recv, ci_cmpt, ci_time);
-                    fclose(file);
+                    out->Row({(double)memory, t_zero, t_recv, t_cmpt, time, ci_zero, ci_recv, ci_cmpt, ci_time, t_cons,
+                              ci_cons});
+                    const double* t_stat = avg_send.t_stat;
+                    if (!mean) {
+                        m_log("\tstats: mean = %.2f - median = %.2f - p90 = %.2f - p99 = %.2f - p99.9 = %.2f - "
+                              "trimmed = %.2f [usec]",
+                              t_stat[part_stat_mean] * 1e+6, t_stat[part_stat_median] * 1e+6,
+                              t_stat[part_stat_p90] * 1e+6, t_stat[part_stat_p99] * 1e+6,
+                              t_stat[part_stat_p999] * 1e+6, t_stat[part_stat_trim] * 1e+6);
+                    }
+                    out_stat->Row({(double)memory, t_stat[part_stat_mean], t_stat[part_stat_median],
+                                   t_stat[part_stat_p90], t_stat[part_stat_p99], t_stat[part_stat_p999],
+                                   t_stat[part_stat_trim]});
+                    if (opt_.timeline) {
+                        const double* tl_metric = avg_send.tl_metric;
+                        m_log("\tearly-bird: ready spread = %.2f [usec] - last ready to recv done = %.2f [usec] - received at last ready = %.1f%%",
+                              tl_metric[0] * 1e+6, tl_metric[1] * 1e+6, tl_metric[2] * 100.0);
+                        out_tl->Row({(double)memory, tl_metric[0], tl_metric[1], tl_metric[2]});
+                    }
+                    if (opt_.consume != part_consume_none) {
+                        m_log("\tpipeline: first ready to last consumed = %.2f [usec]", avg_send.t_pipeline * 1e+6);
+                        out_pipe->Row({(double)memory, avg_send.t_pipeline});
+                    }
+                    if (n_pair > 1) {
+                        // the pairs run concurrently: the bandwidth injected by a node is the memory sent by its
+                        // senders over the time of the slowest one
+                        for (int ip = 0; ip < n_pair; ++ip) {
+                            const double pair_bw = ((double)memory / 1.0e+9) / pair_time[ip];
+                            m_log("\tpair %d (node %d): %.2f +- %.2f [usec] - %f [GB/s]", ip, node_id[ip],
+                                  pair_time[ip] * 1e+6, pair_ci[ip] * 1e+6, pair_bw);
+                            out_pair->Row({(double)memory, (double)ip, (double)node_id[ip], pair_time[ip], pair_ci[ip],
+                                           pair_bw});
+                        }
+                        for (int in = 0; in < n_pair; ++in) {
+                            // a node is listed once, by its first sender
+                            bool first = true;
+                            for (int ip = 0; ip < in; ++ip) {
+                                first = first && (node_id[ip] != node_id[in]);
+                            }
+                            if (!first) {
+                                continue;
+                            }
+                            int    node_pair = 0;
+                            double node_time = 0.0;
+                            for (int ip = in; ip < n_pair; ++ip) {
+                                if (node_id[ip] == node_id[in]) {
+                                    node_pair++;
+                                    node_time = m_max(node_time, pair_time[ip]);
+                                }
+                            }
+                            const double node_bw = ((double)(node_pair * memory) / 1.0e+9) / node_time;
+                            m_log("\tnode %d: %d pairs - %f [GB/s]", node_id[in], node_pair, node_bw);
+                            out_node->Row({(double)memory, (double)node_id[in], (double)node_pair, node_bw});
+                        }
+                    }
                 }
-            } else {
-                // send the receive time to the sender
-                MPI_Send(&t_zero, 1, MPI_DOUBLE, 0, 404, MPI_COMM_WORLD);
-                MPI_Send(&std_zero, 1, MPI_DOUBLE, 0, 405, MPI_COMM_WORLD);
-
-                MPI_Recv(&rerun, 1, MPI_INT, 0, 406, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
             }
-
             // decide if we want to rerun the simulation based on the 90%-CI
+            MPI_Bcast(&rerun, 1, MPI_INT, 0, MPI_COMM_WORLD);
         } while (rerun <= MAX_RERUN);
+        // store the samples of the reported round
+        if (PartRaw::Enabled()) {
+            char filename[512];
+            FileName(512, filename);
+            part_raw_entry_t entry = {};
+            const int len = snprintf(entry.test, sizeof(entry.test), "%s%s", pingpong ? "pingpong_" : "", filename);
+            m_assert(len < (int)sizeof(entry.test), "the test name <%s> is too long for the raw index", filename);
+            entry.size      = info.size.bandwidth;
+            entry.n_iter    = n_iter;
+            entry.i_first   = i_first;
+            entry.n_threads = n_threads;
+            entry.rank      = rank;
+            entry.n_ranks   = comm_size;
+            entry.sender    = sender;
+            entry.pingpong  = pingpong;
+            PartRaw::Append(&entry, t0_data, t0_cmpt_data, t_thread, c_thread);
+        }
+        free(t0_data);
+        free(t0_cmpt_data);
+        free(t_event);
+        free(t_done);
+        free(t_pipe);
+        free(t_thread);
+        free(c_thread);
         //..................................................................
+        MPI_Barrier(MPI_COMM_WORLD);
+        t_setup[1] = PartTimer::Now();
+        if (pingpong) {
+            pong_->RequestCleanup(&info);
+        }
         RequestCleanup(&info);
-        free(info.buf);
+        t_setup[1] = PartTimer::Now() - t_setup[1];
+        double t_setup_max[2];
+        MPI_Reduce(t_setup, t_setup_max, 2, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        if (rank == 0) {
+            // the number of iterations whose cost equals the one of the setup
+            const double n_even = (t_setup_max[0] + t_setup_max[1]) / t_step;
+            m_log("\tsetup: init = %.2f [usec] - cleanup = %.2f [usec] - break-even = %.1f iterations",
+                  t_setup_max[0] * 1e+6, t_setup_max[1] * 1e+6, n_even);
+            out_setup->Row({(double)info.size.bandwidth, t_setup_max[0], t_setup_max[1], t_step, n_even});
+        }
+        PartArena::Release(opt_.arena, info.buf);
+        PartArena::Release(opt_.arena, kernel_aux_[0]);
+        PartArena::Release(opt_.arena, kernel_aux_[1]);
+        kernel_aux_[0] = nullptr;
+        kernel_aux_[1] = nullptr;
+        PartArena::Release(opt_.arena, consume_out_);
+        consume_out_ = nullptr;
     }
+    // flush the results files
+    delete out;
+    delete out_setup;
+    delete out_stat;
+    delete out_tl;
+    delete out_pipe;
+    delete out_pair;
+    delete out_node;
+    free(delay);
+    free(node_id);
+    free(all_time);
+    free(pair_time);
+    free(pair_ci);
 }
 
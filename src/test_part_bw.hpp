@@ -12,6 +12,16 @@
 #include <omp.h>
 #include <iostream>
 #include <cstdlib>
+#include <string>
+#include "alloc.hpp"
+#include "arena.hpp"
+#include "kernel.hpp"
+#include "noise.hpp"
+#include "output.hpp"
+#include "raw.hpp"
+#include "rma_win.hpp"
+#include "stats.hpp"
+#include "win_cache.hpp"
 
 using part_arg_t       = std::tuple<int, int, int, int, int>;
 constexpr int part_arg_s = std::tuple_size_v<part_arg_t>;
@@ -23,6 +33,46 @@ struct BwPartInfo {
     MPI_Datatype dtype = MPI_DATATYPE_NULL;  // the MPI datatype to use for the partitions
 };
 
+// the measurement done by the test
+enum part_mode_t {
+    part_mode_bw       = 0,  // one-directional transfer from the sender to the receiver
+    part_mode_pingpong = 1,  // transfer to the receiver and back, the half round trip is reported
+};
+
+// how the iterations of one size are sampled until the CI is below THRESHOLD_RERUN
+enum part_sampling_t {
+    part_sampling_rerun    = 0,  // the n_warmup + n_repeat iterations are discarded and rerun
+    part_sampling_adaptive = 1,  // batches of n_repeat iterations are added, the warmup is detected from the data
+};
+
+// runtime options of the test, shared by all the strategies
+typedef struct TestPartOpt {
+    int mode     = part_mode_bw;  // see part_mode_t
+    int timeline = 0;             // if 1, record the time of every Pready and partition arrival
+
+    int n_threads = 0;  // the number of threads of the test, 0 for omp_get_max_threads()
+
+    int         noise_model = part_noise_last;  // see part_noise_t
+    std::string noise_trace;                    // the file of recorded delays for part_noise_trace
+
+    int kernel  = part_kernel_none;   // the computation producing each partition before Pready, see part_kernel_t
+    int consume = part_consume_none;  // the computation done on each partition after its arrival, see part_consume_t
+
+    int page  = part_page_default;  // the pages backing the buffers, see part_page_t
+    int align = 64;                 // the alignment of the buffers in bytes
+    int arena = part_arena_none;    // the origin of the buffers, see part_arena_t
+
+    int win_cache  = 0;                   // if 1, the RMA windows are kept across the sizes and the tests, see win_cache.hpp
+    int win_flavor = part_flavor_create;  // how the RMA windows are created, see part_flavor_t
+
+    int stat = part_stat_mean;  // the statistic reported as the time and deciding the reruns, see part_stat_t
+
+    int sampling = part_sampling_rerun;  // see part_sampling_t
+    int budget   = 60;                   // the time budget of one size in sec for part_sampling_adaptive
+
+    part_meta_t meta;  // the strategy and the values of its parameters, written in the results files
+} TestPartOpt;
+
 typedef struct TestPartInfo{
     struct {
     //int rqst; // the number of requests
@@ -50,12 +100,21 @@ class TestPartBw {
     const int  n_warmup;   // number of warmup iterations to do
     const int  n_repeat;   // number of iterations to do after the warmup ones
     const int  max_count;  // the maximum number of dtypes exchanged
-    const int  noise_lvl;  // the noise expressed as 1e-6 sec/MB of memory per partition
+    const int  noise_lvl;  // the noise expressed as 1e-6 sec/MB of memory per partition (in % of the trace for part_noise_trace)
     BwPartInfo bw_dtype;   // the BwDtype exchanged
 
     int n_threads;
     int n_part;
 
+    TestPartOpt opt_;               // the runtime options, copied at construction
+    bool        reverse_ = false;   // if true, the sender and receiver roles are swapped
+    TestPartBw* pong_    = nullptr; // the test used for the way back of the ping-pong
+
+    static TestPartOpt opt_default_;  // the options given to the next constructed tests
+
+    double* kernel_aux_[2] = {nullptr, nullptr};  // the input arrays of the compute kernels
+    double* consume_out_   = nullptr;             // the output array of the consume kernels
+
    public:
     //--------------------------------------------------------------------------
     TestPartBw() = delete;
@@ -63,8 +122,13 @@ class TestPartBw {
                                           n_warmup{std::get<1>(arg)},
                                           n_repeat{std::get<2>(arg)},
                                           max_count{std::get<3>(arg)},
-                                          noise_lvl{std::get<4>(arg)} {
-        n_threads = omp_get_max_threads();
+                                          noise_lvl{std::get<4>(arg)},
+                                          opt_{opt_default_} {
+        // the cached windows need a buffer which does not move
+        if (opt_.win_cache && opt_.arena == part_arena_none) {
+            opt_.arena = part_arena_malloc;
+        }
+        n_threads = (opt_.n_threads > 0) ? opt_.n_threads : omp_get_max_threads();
         n_part = n_partpt * n_threads;
         int rank;
         MPI_Comm_rank(MPI_COMM_WORLD,&rank);
@@ -86,15 +150,55 @@ class TestPartBw {
         //    omp_set_num_threads(n_threads);
         //}
     };
+    virtual ~TestPartBw() = default;
 
     // run this test
     void run();
 
+    // set the options used by the tests constructed from now on
+    static void SetOpt(const TestPartOpt& opt) { opt_default_ = opt; }
+
+    // give the test used for the way back of the ping-pong mode, must be another instance of the same strategy
+    // the roles of the sender and receiver are swapped for the pong test
+    void SetPong(TestPartBw* pong) {
+        pong_           = pong;
+        pong_->reverse_ = true;
+    }
+
    protected:
+    // returns true if this rank sends the data (the roles are swapped for the pong)
+    bool IsSender() const {
+        int rank, comm_size;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
+        return is_sender(rank, comm_size) != reverse_;
+    }
+
+    // true if the RMA windows are taken from the cache, see win_cache.hpp
+    bool WinCache() const { return opt_.win_cache; }
+    // the key of the cached windows of a strategy, they depend on the flavor, the number of threads and the role
+    std::string WinKey(const char* name) const {
+        return std::string(name) + "_" + std::to_string(opt_.win_flavor) + "_" + std::to_string(n_threads) +
+               (IsSender() ? "_send" : "_recv");
+    }
+    // the size of the windows exposing the buffer, the maximum one if the windows are cached
+    MPI_Aint WinSize(const TestPartInfo* info) const {
+        return WinCache() ? (MPI_Aint)max_count * sizeof(double) : info->size.per_part * n_part * sizeof(double);
+    }
+
     virtual void FileName(int len, char* filename) {
        snprintf(filename, len, "%dthreads_%dparts_%dnoise.txt", n_threads, n_part, noise_lvl);
     };
 
+    // the memory where the partition i_part lands on the receiver, read by the consume kernels
+    virtual double* RecvPart(const TestPartInfo* info, const int i_part) {
+        return info->buf + i_part * info->size.per_part;
+    }
+
+    // returns true if Recv_Pready(i) returns once the partition i has arrived,
+    // false if the arrival is only known once the communication completes
+    virtual bool PartArrival() const { return true; }
+
     virtual void RequestInit(TestPartInfo* info)    = 0;
     virtual void Send_StartPreCompute()             = 0;
     virtual void Send_Pready(const int i_part)      = 0;
@@ -105,7 +209,15 @@ class TestPartBw {
     virtual void RequestCleanup(TestPartInfo* info) = 0;
 
    private:
-    void get_noise_(const int npart, double* noise);
+    double Transfer_(TestPartBw* test, const bool sender, const TestPartInfo* info, const int kernel, const int consume,
+                     const double* delay, const double t_start, double* t_event, double* t_pipe);
+    // the measured iterations are [i_first, n_iter)
+    void   Timeline_(const bool sender, const int buddy, const int i_first, const int n_iter, const double* t_event,
+                     const double* t_done, double* metric);
+    double Pipeline_(const bool sender, const int buddy, const int i_first, const int n_iter, const double* t_pipe);
+    double Stats_(const bool sender, const int buddy, const int i_first, const int n_iter, const double* t0_data,
+                  const double* t0_cmpt_data, double* value);
+    void*  Alloc_(const int slot, const size_t size);
 };
 
 #endif
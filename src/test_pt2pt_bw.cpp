@@ -3,6 +3,8 @@
  *	See COPYRIGHT in top-level directory
  */
 #include "test_pt2pt_bw.hpp"
+#include "output.hpp"
+#include "timer.hpp"
 #include "tools.hpp"
 // run the Bandwdith test
 // the test sends n_msg times an increasing number of datatype information.
@@ -45,9 +47,13 @@ void TestPt2PtBw::run()
     Filename(512, filename);
 
     // pre-open the file
-    FILE *file;
+    PartOutput* out = nullptr;
     if (rank == 0) {
-        file = fopen(filename, "w+");
+        const part_meta_t meta = {{"test", filename},
+                                  {"n_msg", std::to_string(n_msg)},
+                                  {"n_repeat", std::to_string(n_repeat)},
+                                  {"max_count", std::to_string(max_count)}};
+        out = new PartOutput((std::string("results/") + filename).c_str(), meta, {{"memory_gb", false}, {"bw", false}});
     }
 
     //--------------------------------------------------------------------------
@@ -58,7 +64,7 @@ void TestPt2PtBw::run()
             size_t buf_count = 0;  // counts the memory in char (the send/recv buffer is in char)
  
             MPI_Barrier(MPI_COMM_WORLD);
-            double t0 = MPI_Wtime();
+            double t0 = PartTimer::Now();
             //----------------------------------------------------------------------
             if (send) {
                 // send back-to-back msgs
@@ -85,19 +91,21 @@ void TestPt2PtBw::run()
                     // recv in the buffer
                     const int mpi_count = count * bw_dtype.dcount;
                     MPI_Irecv(lbuf, mpi_count, bw_dtype.dtype, buddy, 100+is, MPI_COMM_WORLD, rqst + is);
-                    // post-pro the received buffer
-                    PostRecv(is, count, lbuf);
                     // increment the memory count
                     buf_count += count * bw_dtype.alloc_byte / sizeof(char);
                 }
                 MPI_Waitall(n_msg, rqst, MPI_STATUSES_IGNORE);
+                // post-pro the received buffers, once they have arrived
+                for (int is = 0; is < n_msg; ++is) {
+                    PostRecv(is, count, buf + is * count * bw_dtype.alloc_byte);
+                }
 
                 // sendthe handshake - 4 bytes
                 MPI_Send(hdshake_buf, 4, MPI_CHAR, buddy, 1, MPI_COMM_WORLD);
             }
 
             //---------------------------------------------------------------------
-            time_acc += MPI_Wtime() - t0;
+            time_acc += PartTimer::Now() - t0;
         }
         // get the averaged time among ranks
         double glbl_time;
@@ -111,12 +119,10 @@ void TestPt2PtBw::run()
         // print into the diag file
         if (rank == 0) {
             m_log("%f MB - %f [GB/s]", comm_mem*1e+3, comm_mem / time_acc);
-            fprintf(file, "%f,%e\n", comm_mem, comm_mem / time_acc);
+            out->Row({comm_mem, comm_mem / time_acc});
         }
     }
-    if (rank == 0) {
-        fclose(file);
-    }
+    delete out;
 
     UpsetComm(max_count,n_msg,&bw_dtype);
 
@@ -50,6 +50,7 @@ class TestPt2PtBw {
                                          max_count{std::get<0>(arg)} {
         m_info(arg);
     };
+    virtual ~TestPt2PtBw() = default;
 
     // run this test
     void run();
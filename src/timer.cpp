@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "timer.hpp"
+
+#include <cfloat>
+
+#include "tools.hpp"
+
+#define TIMER_CALIB_TIME 0.01  // the calibration time of the cycle counter in sec
+#define TIMER_N_CALL     1000  // the number of calls measuring the resolution and the overhead
+
+int      PartTimer::timer_      = part_timer_wtime;
+uint64_t PartTimer::cycle0_     = 0;
+double   PartTimer::cycle_time_ = 1.0e-9;
+double   PartTimer::resolution_ = 0.0;
+double   PartTimer::overhead_   = 0.0;
+
+static double mono_now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return ts.tv_sec + 1.0e-9 * ts.tv_nsec;
+}
+
+void PartTimer::Calibrate_() {
+    // the cycle counter is read inside the clock reads, the error is the one of a clock read over the calibration time
+    const double   t0 = mono_now();
+    const uint64_t c0 = timer_cycles();
+    double         t1;
+    do {
+        t1 = mono_now();
+    } while ((t1 - t0) < TIMER_CALIB_TIME);
+    const uint64_t c1 = timer_cycles();
+    cycle0_     = c0;
+    cycle_time_ = (t1 - t0) / (c1 - c0);
+}
+
+void PartTimer::Init(const int timer) {
+    // the cycle counter is also used by noise_spin(), it is calibrated for every timer
+    Calibrate_();
+    timer_ = timer;
+
+    // the resolution is the smallest step seen by consecutive calls
+    double resolution = DBL_MAX;
+    for (int i = 0; i < TIMER_N_CALL; ++i) {
+        const double t0 = Now();
+        double       t1;
+        do {
+            t1 = Now();
+        } while (t1 == t0);
+        resolution = m_min(resolution, t1 - t0);
+    }
+    resolution_ = resolution;
+
+    // the overhead is the average cost of one call, the sum prevents the compiler from dropping the calls
+    volatile double sum = 0.0;
+    const double    t0  = Now();
+    for (int i = 0; i < TIMER_N_CALL; ++i) {
+        sum = sum + Now();
+    }
+    overhead_ = (Now() - t0) / TIMER_N_CALL;
+}
+
+const char* PartTimer::Name() {
+    const char* name[3] = {"MPI_Wtime", "tsc", "CLOCK_MONOTONIC_RAW"};
+    return name[timer_];
+}
+
+void PartTimer::Log() {
+    m_log("timer: %s - resolution = %.1f [nsec] - overhead = %.1f [nsec] - cycle counter = %.3f [GHz]", Name(),
+          resolution_ * 1e+9, overhead_ * 1e+9, CycleFreq() * 1e-9);
+}
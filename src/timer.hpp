@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef TIMER_HPP_
+#define TIMER_HPP_
+
+#include <mpi.h>
+#include <time.h>
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// the clock behind PartTimer::Now()
+enum part_timer_t {
+    part_timer_wtime = 0,  // MPI_Wtime
+    part_timer_tsc   = 1,  // the cycle counter (rdtsc, cntvct_el0), calibrated at startup
+    part_timer_mono  = 2,  // clock_gettime(CLOCK_MONOTONIC_RAW)
+};
+
+// the cycle counter, the monotonic clock in nsec if the architecture has none
+static inline uint64_t timer_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t val;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(val));
+    return val;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+/* The timer used for every measurement of the benchmark
+ *
+ * Init() selects the clock, calibrates the cycle counter against CLOCK_MONOTONIC_RAW and measures the resolution
+ * (the smallest non-zero difference between two consecutive calls) and the overhead (the average cost of one call)
+ * of Now(). Now() returns a time in seconds from an arbitrary origin, only differences are meaningful.
+ * The cycle counter is assumed to be invariant and synchronized between the cores (constant_tsc on x86).
+ */
+class PartTimer {
+   public:
+    static void Init(const int timer);
+    // log the clock, its resolution and its overhead
+    static void Log();
+
+    static inline double Now() {
+        switch (timer_) {
+            case part_timer_tsc:
+                return (double)(timer_cycles() - cycle0_) * cycle_time_;
+            case part_timer_mono: {
+                struct timespec ts;
+                clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+                return ts.tv_sec + 1.0e-9 * ts.tv_nsec;
+            }
+            default:
+                return MPI_Wtime();
+        }
+    }
+    // the number of cycles per second of timer_cycles(), used by noise_spin()
+    static double CycleFreq() { return 1.0 / cycle_time_; }
+    static const char* Name();
+    static double Resolution() { return resolution_; }
+    static double Overhead() { return overhead_; }
+
+   private:
+    static int      timer_;       // see part_timer_t
+    static uint64_t cycle0_;      // the origin of the cycle counter
+    static double   cycle_time_;  // the time of one cycle in seconds
+    static double   resolution_;
+    static double   overhead_;
+
+    static void Calibrate_();
+};
+
+#endif
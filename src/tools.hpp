@@ -7,6 +7,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <tuple>
+#include <utility>
+#include <vector>
 #include <mpi.h>
 
 
@@ -60,6 +62,9 @@ typedef struct {
     MPI_Win  win;
     MPI_Comm comm;
     MPI_Group group;
+    MPI_Aint disp;   // the target displacement of the beginning of the buffer
+    void*    local;  // the memory exposed by the window, the beginning of the buffer on the receiver
+    int      flavor; // how the window has been created, see part_flavor_t
 } put_info_t;
 
 //==============================================================================
@@ -303,6 +308,18 @@ constexpr auto head(std::tuple<Tp...> &t) -> decltype(idx_get(t, typename iota<I
     return idx_get(t, typename iota<I>::type());
 }
 
+//--------------------------------------------------------------------------
+// build a tuple of int from a runtime list of values, the list must have the size of the tuple
+template <typename Tp, size_t... idx>
+Tp from_vector_(const std::vector<int> &v, std::index_sequence<idx...>) {
+    return Tp(v[idx]...);
+}
+template <typename Tp>
+Tp from_vector(const std::vector<int> &v) {
+    m_assert(v.size() == std::tuple_size_v<Tp>, "the list has %ld values instead of %ld", v.size(), std::tuple_size_v<Tp>);
+    return from_vector_<Tp>(v, std::make_index_sequence<std::tuple_size_v<Tp>>());
+}
+
 };  // namespace test
 
 #define m_values(...)    test::values<int, __VA_ARGS__>
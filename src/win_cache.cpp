@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#include "win_cache.hpp"
+
+std::vector<PartWinCache::entry_t> PartWinCache::list_;
+
+put_info_t* PartWinCache::Find(const std::string& key, const void* buf, const size_t size, const int n_info) {
+    for (auto it = list_.begin(); it != list_.end(); ++it) {
+        if (it->key != key) {
+            continue;
+        }
+        if (it->buf == buf && it->size >= size && it->n_info == n_info) {
+            return it->info;
+        }
+        // the buffer has changed, the windows are freed
+        it->win_free(it->info, it->n_info, it->sender);
+        list_.erase(it);
+        return nullptr;
+    }
+    return nullptr;
+}
+
+void PartWinCache::Store(const std::string& key, put_info_t* info, const int n_info, const void* buf,
+                         const size_t size, const bool sender, win_free_t win_free) {
+    list_.push_back({key, info, n_info, buf, size, sender, win_free});
+}
+
+void PartWinCache::Release(const void* ptr, const size_t size) {
+    const char* begin = (const char*)ptr;
+    for (auto it = list_.begin(); it != list_.end();) {
+        const char* buf = (const char*)it->buf;
+        if (begin <= buf && buf < begin + size) {
+            it->win_free(it->info, it->n_info, it->sender);
+            it = list_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void PartWinCache::Free() {
+    for (entry_t& entry : list_) {
+        entry.win_free(entry.info, entry.n_info, entry.sender);
+    }
+    list_.clear();
+}
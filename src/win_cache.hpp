@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) by Argonne National Laboratory
+ *	See COPYRIGHT in top-level directory
+ */
+#ifndef WIN_CACHE_HPP_
+#define WIN_CACHE_HPP_
+
+#include <mpi.h>
+
+#include <string>
+#include <vector>
+
+#include "tools.hpp"
+
+// free the windows and comms of n_info put_info_t as well as the array itself
+using win_free_t = void (*)(put_info_t* info, const int n_info, const bool sender);
+
+/* Windows and communicators of the RMA strategies, kept across the sizes and the tests
+ *
+ * A strategy looks for its windows with Find() and gives the ones it creates to Store(), the cache then owns them.
+ * The windows expose the whole buffer, which must not move: the buffers then come from the arena (see arena.hpp),
+ * which releases the windows of a buffer before freeing or reallocating it.
+ * The entries are created and freed in the same order on every rank as the window operations are collective.
+ */
+class PartWinCache {
+   public:
+    // return the windows of key exposing size bytes of buf, nullptr if they must be created
+    static put_info_t* Find(const std::string& key, const void* buf, const size_t size, const int n_info);
+    static void        Store(const std::string& key, put_info_t* info, const int n_info, const void* buf,
+                             const size_t size, const bool sender, win_free_t win_free);
+    // free the windows exposing a part of the size bytes at ptr, called by the arena before it frees a buffer
+    static void Release(const void* ptr, const size_t size);
+    // free all the windows, must be called before the arena is freed
+    static void Free();
+
+   private:
+    typedef struct {
+        std::string key;
+        put_info_t* info;
+        int         n_info;
+        const void* buf;
+        size_t      size;
+        bool        sender;
+        win_free_t  win_free;
+    } entry_t;
+    static std::vector<entry_t> list_;
+};
+
+#endif